@@ -5,12 +5,18 @@ using namespace nall;
 using namespace hiro;
 
 #include "amethyst.hpp"
+wakeup workerWakeup;  //signalled by the worker threads once they post results; defined first so that it outlives them
 namespace Instances { Instance<Program> program; }
 namespace Instances { Instance<SaveDialog> saveDialog; }
+namespace Instances { Instance<QuickOpen> quickOpen; }
+namespace Instances { Instance<FindInFiles> findInFiles; }
 Program& program = Instances::program();
 SaveDialog& saveDialog = Instances::saveDialog();
-Markup::Node settings;
+QuickOpen& quickOpen = Instances::quickOpen();
+FindInFiles& findInFiles = Instances::findInFiles();
+Settings settings;
 Markup::Node mimetypes;
+MimeTypes mimeTypes;
 
 auto about() -> void {
   AboutDialog()
@@ -28,34 +34,88 @@ auto locate(string location) -> string {
   return {Path::userSettings(), "amethyst/", location};
 }
 
-auto getFont(string path) -> Font {
-  return Font().setFamily(settings[{path, "/family"}].text()).setSize(settings[{path, "/size"}].real());
+auto Settings::load(const Markup::Node& document) -> void {
+  //every path is exact: a Key skips the pattern, range and rule parsing of operator[](string) at each level
+  auto node = [&](const string& path) { return document[Markup::Key{path}]; };
+  auto font = [&](string path) {
+    return Font().setFamily(node({path, "/family"}).text()).setSize(node({path, "/size"}).real());
+  };
+  auto color = [&](string path) {
+    return Color().setValue(255 << 24 | node(path).natural());
+  };
+  auto pane = [&](Pane& pane, string path) {
+    pane.font = font({path, "/font"});
+    pane.background = color({path, "/color/background"});
+    pane.standard = color({path, "/color/standard"});
+  };
+
+  window.x = node("window/x").real();
+  window.y = node("window/y").real();
+  window.width = node("window/width").real();
+  window.height = node("window/height").real();
+  window.font = font("window/font");
+  menu.font = font("menu/font");
+  pane(browser, "browser");
+  browser.width = node("browser/width").real();
+  browser.modified = color("browser/color/modified");
+  browser.desynced = color("browser/color/desynced");
+  browser.readonly = color("browser/color/readonly");
+  pane(editor, "editor");
+  editor.scheme = node("editor/scheme").text();
+  editor.budget = node("editor/budget").real();
+  pane(find, "find");
+  pane(jump, "goto");
+  pane(save, "save");
+  pane(open, "open");
+  pane(search, "search");
 }
 
-auto getColor(string path) -> Color {
-  return Color().setValue(255 << 24 | settings[path].natural());
+//every string is copied from document, so that a SearchJob may use its own MimeTypes on worker threads
+auto MimeTypes::load(const Markup::Node& document) -> void {
+  rules.reset();
+  types.reset();
+  for(auto file : document.find("file")) {
+    rules.append(file["match"].text());
+    types.append((const char*)file["type"].text());
+  }
 }
 
-auto getFloat(string path) -> float {
-  return settings[path].real();
+auto MimeTypes::language(string_view name) -> string {
+  if(auto index = rules.find(name)) return types[*index];
+  return {};
+}
+
+uint64_t Document::relinks = 1;
+
+//parent location followed by segment, rebuilt only after a document was relinked since the last call
+auto Document::location() const -> const string& {
+  if(cachedRelinks != relinks) {
+    cachedLocation = parent ? string{parent->location(), segment} : segment;
+    cachedRelinks = relinks;
+  }
+  return cachedLocation;
 }
 
-auto getString(string path) -> string {
-  return settings[path].text();
+//change segment, keeping the document under the new name in its parent
+auto Document::relink(string segment) -> void {
+  auto& siblings = parent ? parent->children : program.documents;
+  auto self = siblings.find(this->segment);
+  if(!self) return;
+  auto document = self();  //siblings.remove() would release the last reference
+  siblings.remove(this->segment);
+  this->segment = segment;
+  siblings.insert(segment, document);
+  relinks++;
 }
 
 //color syntax highlighting
 auto Document::language() const -> string {
-  auto name = Location::base(location);
-  for(auto file : mimetypes.find("file")) {
-    if(name.match(file["match"].text())) return file["type"].text();
-  }
-  return {};  //treat unmatched files as binary files
+  return mimeTypes.language(Location::base(location()));  //treat unmatched files as binary files
 }
 
 //filename
 auto Document::name() const -> string {
-  string name = Location::base(location);
+  string name = Location::base(location());
   if(type == "folder") return name.trimRight("/", 1L);
   if(!name) name = "(untitled)";
   if(modified) name.prepend("*");
@@ -66,7 +126,7 @@ auto Document::name() const -> string {
 //filename (pathname)
 auto Document::title() const -> string {
   string title = name();
-  if(location) title.append(" (", Location::dir(location), ")");
+  if(location()) title.append(" (", Location::dir(location()), ")");
   if(!writable) title.append(" [read-only]");
   return title;
 }
@@ -82,38 +142,487 @@ auto Document::update() -> void {
   if(type == "binary") treeViewItem.setIcon(Icon::Emblem::Binary);
   if(type == "text") treeViewItem.setIcon(Icon::Emblem::Text);
   if(!writable) {
-    treeViewItem.setForegroundColor(getColor("browser/color/readonly"));
+    treeViewItem.setForegroundColor(settings.browser.readonly);
   } else if(modified) {
-    treeViewItem.setForegroundColor(getColor("browser/color/modified"));
+    treeViewItem.setForegroundColor(settings.browser.modified);
   } else if(desynced) {
-    treeViewItem.setForegroundColor(getColor("browser/color/desynced"));
+    treeViewItem.setForegroundColor(settings.browser.desynced);
   } else {
-    treeViewItem.setForegroundColor(getColor("browser/color/standard"));
+    treeViewItem.setForegroundColor(settings.browser.standard);
   }
   treeViewItem.setText(name());
 }
 
-//update the location of a document and all of its children
+//rename the document: the locations of its children follow, since they are built from its own
 auto Document::rename(string name) -> void {
-  auto oldLocation = location;
-  auto newLocation = Location::dir(location).append(name);
-  location = newLocation;
+  relink(parent ? name : Location::dir(segment).append(name));
   update();
-  for(auto document : program.documents) {
-    if(document.data() == this) continue;  //location already updated
-    if(!document->location.beginsWith(oldLocation)) continue;  //not a descendent of the renamed document
-    document->location.trimLeft(oldLocation, 1L);
-    document->location.prepend(newLocation);
-    document->update();
-  }
   program.setTitle();
 }
 
+//runs on a worker thread: only LargeFile::map, LargeFile::cancelled, the mutex-guarded fields and workerWakeup may be touched here
+static auto largeFileWorker(uintptr parameter) -> void {
+  auto large = (LargeFile*)parameter;
+  auto data = (const char*)large->map.data();
+  uint64_t size = large->map.size();
+  uint64_t lines = 1;
+  vector<uint64_t> checkpoints;
+  for(uint64_t chunk = 0; chunk < size && !large->cancelled; chunk += 64 * 1024 * 1024) {
+    uint64_t end = min(size, chunk + 64 * 1024 * 1024);
+    auto p = data + chunk;
+    //another program may truncate the file: the lines of the chunks counted in full are kept
+    bool counted = file_map::guard([&] {
+      while(auto newline = (const char*)memchr(p, '\n', data + end - p)) {
+        p = newline + 1;
+        if(p == data + size) break;  //a final newline does not begin another line
+        if(lines % LargeFile::Stride == 0) checkpoints.append(p - data);
+        lines++;
+      }
+    });
+    if(!counted) break;
+    large->map.release(chunk, end - chunk);  //keep resident memory proportional to the window, not the file
+    {
+      lock_guard<mutex> guard(large->lock);
+      large->checkpoints.append(move(checkpoints));
+      large->lines = lines;
+      checkpoints.reset();
+    }
+    workerWakeup.signal();  //the window bar shows the lines counted so far
+  }
+  {
+    lock_guard<mutex> guard(large->lock);
+    large->finished = true;
+  }
+  workerWakeup.signal();
+}
+
+LargeFile::~LargeFile() {
+  if(!active) return;
+  cancelled = true;
+  worker.join();
+}
+
+auto LargeFile::open(const string& location) -> bool {
+  if(!map.open(location, file_map::mode::read)) return false;
+  checkpoints.append(0);
+  active = true;
+  worker = thread::create(largeFileWorker, (uintptr)this);
+  return true;
+}
+
+//true once every line has been indexed
+auto LargeFile::indexed() -> bool {
+  lock_guard<mutex> guard(lock);
+  return finished;
+}
+
+//number of lines indexed so far
+auto LargeFile::lineCount() -> uint64_t {
+  lock_guard<mutex> guard(lock);
+  return lines;
+}
+
+//offset of line (0-based), or the end of the file when there are not that many lines
+//lines past the index are found by scanning forward, so this is correct even while the index is being built
+auto LargeFile::lineOffset(uint64_t line) -> uint64_t {
+  uint64_t offset = 0;
+  {
+    lock_guard<mutex> guard(lock);
+    uint64_t checkpoint = min(line / Stride, (uint64_t)checkpoints.size() - 1);
+    offset = checkpoints[checkpoint];
+    line -= checkpoint * Stride;
+  }
+  auto data = (const char*)map.data();
+  uint64_t size = map.size();
+  bool readable = file_map::guard([&] {
+    while(line--) {
+      auto newline = (const char*)memchr(data + offset, '\n', size - offset);
+      if(!newline) return (void)(offset = size);
+      offset = newline + 1 - data;
+    }
+  });
+  return readable ? offset : size;  //the file was truncated since it was mapped
+}
+
+//0-based line containing the byte at offset
+auto LargeFile::lineAt(uint64_t offset) -> uint64_t {
+  uint64_t line = 0, start = 0;
+  {
+    lock_guard<mutex> guard(lock);
+    uint64_t lower = 0, upper = checkpoints.size();  //find the last checkpoint at or before offset
+    while(upper - lower > 1) {
+      uint64_t middle = (lower + upper) / 2;
+      if(checkpoints[middle] <= offset) lower = middle;
+      else upper = middle;
+    }
+    line = lower * Stride;
+    start = checkpoints[lower];
+  }
+  auto data = (const char*)map.data();
+  file_map::guard([&] {  //if the file was truncated since it was mapped, the line is only approximate
+    while(auto newline = (const char*)memchr(data + start, '\n', offset - start)) {
+      start = newline + 1 - data;
+      line++;
+    }
+  });
+  return line;
+}
+
+//returns the text of up to WindowLines lines beginning at line; lines longer than WindowSize are truncated
+auto LargeFile::setWindow(uint64_t line) -> string {
+  auto data = (const char*)map.data();
+  windowLine = line;
+  windowLines = 0;
+  windowStart = windowEnd = lineOffset(line);
+  uint64_t limit = min(map.size(), windowStart + WindowSize);
+  string text;
+  bool readable = file_map::guard([&] {
+    while(windowLines < WindowLines && windowEnd < limit) {
+      auto newline = (const char*)memchr(data + windowEnd, '\n', limit - windowEnd);
+      windowEnd = newline ? newline + 1 - data : limit;
+      windowLines++;
+    }
+    //do not split a UTF-8 sequence
+    while(windowEnd > windowStart && windowEnd < map.size() && (data[windowEnd] & 0xc0) == 0x80) windowEnd--;
+    windowOffsets.reset(data + windowStart, windowEnd - windowStart);
+    text = string{string_view{data + windowStart, uint(windowEnd - windowStart)}};
+  });
+  if(readable) return text;
+  //the file was truncated since it was mapped: show nothing until it is opened again
+  windowEnd = windowStart;
+  windowLines = 0;
+  windowOffsets.reset();
+  return {};
+}
+
+//converts a SourceEdit character offset into a byte offset within the file
+auto LargeFile::windowOffset(uint characters) const -> uint64_t {
+  uint64_t offset = 0;
+  file_map::guard([&] { offset = windowOffsets.offset(characters); });  //0 if the file was truncated
+  return windowStart + offset;
+}
+
+//set of the (case-folded) characters in text: a query can only match paths that contain all of its characters
+static auto fuzzyMask(const char* text, uint size) -> uint64_t {
+  uint64_t mask = 0;
+  for(uint n : range(size)) {
+    uint8_t c = text[n];
+    if(c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    if(c >= 'a' && c <= 'z') mask |= 1ull << (c - 'a');
+    else if(c >= '0' && c <= '9') mask |= 1ull << (26 + c - '0');
+    else mask |= 1ull << (36 + c % 28);
+  }
+  return mask;
+}
+
+//query must be lowercase
+static auto fuzzyContains(const char* path, uint size, const char* query, uint length) -> bool {
+  for(uint offset = 0; offset < size && length; offset++) {
+    char c = path[offset];
+    if(c >= 'A' && c <= 'Z') c += 'a' - 'A';
+    if(c == *query) query++, length--;
+  }
+  return !length;
+}
+
+//the highest score that fuzzyScore() could possibly return for a path of this size
+//(the first character matched can never be consecutive with a previous one)
+static auto fuzzyBound(uint size, uint length) -> int {
+  return 1000 - (int)size + 55 * (int)length - 15;
+}
+
+//query must be lowercase, and a subsequence of path
+//characters are matched from right to left, so that matches prefer the file name over its folders
+static auto fuzzyScore(const char* path, uint size, const char* query, uint length) -> int {
+  uint basename = size;
+  while(basename && path[basename - 1] != '/') basename--;
+  int score = 1000 - (int)size;  //prefer shorter paths
+  int remaining = length;
+  int previous = -2;
+  for(int offset = (int)size - 1; offset >= 0 && remaining; offset--) {
+    char c = path[offset];
+    char lower = c >= 'A' && c <= 'Z' ? c + 'a' - 'A' : c;
+    if(lower != query[remaining - 1]) continue;
+    char before = offset ? path[offset - 1] : '/';
+    score += 10;
+    if(offset >= basename) score += 10;
+    if(previous == offset + 1) score += 15;  //consecutive characters
+    if(before == '/' || before == '_' || before == '-' || before == '.' || before == ' '
+    || (before >= 'a' && before <= 'z' && c >= 'A' && c <= 'Z')) score += 20;  //start of a word
+    previous = offset;
+    remaining--;
+  }
+  return max(1, score);
+}
+
+static auto fileIndexWalk(vector<string>& files, const string& root, const string& relative, uint depth) -> void {
+  if(depth > 64) return;  //guard against symbolic link cycles
+  for(auto& name : directory::contents({root, relative})) {
+    if(name.endsWith("/")) {
+      if(name.beginsWith(".")) continue;  //skip version control and other hidden folders
+      fileIndexWalk(files, root, {relative, name}, depth + 1);
+    } else if(!name.find("\n")) {
+      files.append(string{relative, name});
+    }
+  }
+}
+
+static auto fileIndexAppend(string& text, string_view path) -> void {
+  uint size = text.size();
+  text.resize(size + path.size() + 1);
+  memory::copy(text.get() + size, path.data(), path.size());
+  text.get()[size + path.size()] = 0;
+}
+
+auto FileIndex::cache() const -> string {
+  return {Path::userSettings(), "amethyst/index-", hex(Hash::CRC32(root).value(), 8L), ".txt"};
+}
+
+//the cache stores one path per line, front-coded against the previous path:
+//"<length of prefix shared with the previous path> <remainder of the path>"
+auto FileIndex::load(string root) -> bool {
+  this->root = root;
+  text.reset();
+  reindex();
+  auto data = string::read(cache());
+  const char* p = data.data();
+  const char* end = p + data.size();
+  auto line = [&]() -> string_view {
+    auto start = p;
+    while(p < end && *p != '\n') p++;
+    string_view view{start, uint(p - start)};
+    if(p < end) p++;
+    return view;
+  };
+  if(!root.equals(line())) return false;
+  string previous;
+  while(p < end) {
+    auto entry = line();
+    uint shared = 0, offset = 0;
+    while(offset < entry.size() && entry.data()[offset] != ' ') shared = shared * 10 + entry.data()[offset++] - '0';
+    if(offset++ >= entry.size() || shared > previous.size()) return text.reset(), reindex(), false;
+    previous.resize(shared).append(string_view{entry.data() + offset, entry.size() - offset});
+    fileIndexAppend(text, previous);
+  }
+  reindex();
+  modified = false;
+  return true;
+}
+
+auto FileIndex::save() -> void {
+  if(!modified || !root) return;
+  string data{root, "\n"};
+  for(uint index : range(size())) {
+    auto path = this->path(index);
+    uint shared = 0;
+    if(index) {
+      auto previous = this->path(index - 1);
+      while(shared < path.size() && shared < previous.size() && path.data()[shared] == previous.data()[shared]) shared++;
+    }
+    data.append(shared, " ", string_view{path.data() + shared, path.size() - shared}, "\n");
+  }
+  directory::create({Path::userSettings(), "amethyst/"});
+  if(file::write(cache(), data)) modified = false;
+}
+
+//walk root on a worker thread; poll() merges the result once it completes
+auto FileIndex::build(string root) -> void {
+  if(active) return;
+  this->root = root;
+  pathname = (const char*)root;  //private copy for the worker thread
+  active = true;
+  finished = false;
+  worker = thread::create([&](uintptr) {
+    vector<string> files;
+    fileIndexWalk(files, pathname, "", 0);
+    files.sort();
+    string packed;
+    for(auto& file : files) fileIndexAppend(packed, file);
+    {
+      lock_guard<mutex> guard(lock);
+      built = move(packed);
+      finished = true;
+    }
+    workerWakeup.signal();
+  });
+}
+
+auto FileIndex::poll() -> bool {
+  if(!active) return false;
+  {
+    lock_guard<mutex> guard(lock);
+    if(!finished) return false;
+    text = move(built);
+  }
+  worker.join();
+  active = false;
+  reindex();
+  modified = true;
+  save();
+  return true;
+}
+
+auto FileIndex::insert(string location) -> void {
+  if(!location.beginsWith(root) || location.endsWith("/")) return;
+  auto path = location.trimLeft(root, 1L);
+  uint lower = lowerBound(path);
+  if(lower < size() && path.equals(this->path(lower))) return;
+  string packed;
+  fileIndexAppend(packed, path);
+  splice(lower, lower, packed);
+}
+
+//removes location, or everything beneath it when location is a folder
+auto FileIndex::remove(string location) -> void {
+  if(!location.beginsWith(root)) return;
+  auto path = location.trimLeft(root, 1L);
+  uint lower = lowerBound(path);
+  uint upper = upperBound(path, lower);
+  if(upper > lower) splice(lower, upper);
+}
+
+//the renamed paths share the prefix being replaced, so they stay in order: only their range moves
+auto FileIndex::rename(string oldLocation, string newLocation) -> void {
+  if(!oldLocation.beginsWith(root) || !newLocation.beginsWith(root)) return;
+  auto from = oldLocation.trimLeft(root, 1L);
+  auto to = newLocation.trimLeft(root, 1L);
+  uint lower = lowerBound(from);
+  uint upper = upperBound(from, lower);
+  if(upper == lower) return;
+  vector<string> renamed;
+  for(uint index : range(lower, upper)) {
+    auto path = this->path(index);
+    renamed.append(string{to, string_view{path.data() + from.size(), path.size() - from.size()}});
+  }
+  splice(lower, upper);
+  //merge with the paths already at the new location: a file renamed over another one replaces it
+  lower = lowerBound(to);
+  upper = upperBound(to, lower);
+  string packed;
+  for(uint x = lower, y = 0; x < upper || y < renamed.size();) {
+    if(y == renamed.size() || (x < upper && string::compare(path(x), renamed[y]) < 0)) {
+      fileIndexAppend(packed, path(x++));
+    } else {
+      if(x < upper && renamed[y] == path(x)) x++;
+      fileIndexAppend(packed, renamed[y++]);
+    }
+  }
+  splice(lower, upper, packed);
+}
+
+//returns the indexes of the best limit matches for query, highest ranked first
+auto FileIndex::search(string query, uint limit) -> vector<uint> {
+  query.replace(" ", "").downcase();
+  auto needle = query.data();
+  auto length = query.size();
+  auto mask = fuzzyMask(needle, length);
+  auto data = text.data();
+  auto offset = offsets.data();
+  auto set = masks.data();
+  bool narrowing = lastQuery && query.beginsWith(lastQuery);
+
+  struct Result { int score; uint index; };
+  vector<Result> results;
+  vector<uint> matches;
+  auto test = [&](uint index) {
+    if((set[index] & mask) != mask) return;
+    auto path = data + offset[index];
+    uint size = offset[index + 1] - offset[index] - 1;
+    if(!fuzzyContains(path, size, needle, length)) return;
+    matches.append(index);
+    //only score paths that could still make it into the results
+    if(results.size() == limit && fuzzyBound(size, length) <= results.right().score) return;
+    int score = fuzzyScore(path, size, needle, length);
+    if(results.size() == limit && score <= results.right().score) return;
+    uint position = results.size();
+    while(position && results[position - 1].score < score) position--;
+    results.insert(position, {score, index});
+    if(results.size() > limit) results.removeRight();
+  };
+  if(narrowing) {
+    for(auto index : lastMatches) test(index);
+  } else {
+    for(uint index : range(size())) test(index);
+  }
+  lastQuery = query;
+  lastMatches = move(matches);
+
+  vector<uint> indexes;
+  for(auto& result : results) indexes.append(result.index);
+  return indexes;
+}
+
+//a private copy of every path, for use by other threads
+auto FileIndex::snapshot() const -> string {
+  string copy;
+  copy.resize(text.size());
+  memory::copy(copy.get(), text.data(), text.size());
+  return copy;
+}
+
+auto FileIndex::lowerBound(string_view path) const -> uint {
+  uint lower = 0, upper = size();
+  while(lower < upper) {
+    uint middle = (lower + upper) / 2;
+    auto entry = this->path(middle);
+    if(string::compare(entry, path) < 0) lower = middle + 1;
+    else upper = middle;
+  }
+  return lower;
+}
+
+//end of the paths from lower that equal path, or that are beneath it when path is a folder
+auto FileIndex::upperBound(string_view path, uint lower) const -> uint {
+  bool folder = path.size() && path.data()[path.size() - 1] == '/';
+  uint upper = lower;
+  while(upper < size()) {
+    string_view entry = this->path(upper);
+    if(folder ? memory::compare(entry.data(), min(entry.size(), path.size()), path.data(), path.size()) : string::compare(entry, path)) break;
+    upper++;
+  }
+  return upper;
+}
+
+//replace the paths in [lower, upper) with packed: paths in sorted order, each followed by a null byte
+auto FileIndex::splice(uint lower, uint upper, string_view packed) -> void {
+  uint head = offsets[lower];
+  uint tail = text.size() - offsets[upper];
+  string next;
+  next.resize(head + packed.size() + tail);
+  memory::copy(next.get(), text.data(), head);
+  memory::copy(next.get() + head, packed.data(), packed.size());
+  memory::copy(next.get() + head + packed.size(), text.data() + offsets[upper], tail);
+  text = move(next);
+  reindex();
+  modified = true;
+}
+
+//rebuild offsets and masks after text changes
+auto FileIndex::reindex() -> void {
+  offsets.reset();
+  masks.reset();
+  uint start = 0;
+  for(uint offset : range(text.size())) {
+    if(text.data()[offset]) continue;
+    offsets.append(start);
+    masks.append(fuzzyMask(text.data() + start, offset - start));
+    start = offset + 1;
+  }
+  offsets.append(start);
+  lastQuery.reset();
+  lastMatches.reset();
+}
+
 Program::Program() {
   fileMenu.setText("File");
-  saveAction.setText("Save").setIcon(Icon::Action::Save).onActivate([&] { documentSave(program, documentActive()); });
+  openAction.setText("Open File ...").setIcon(Icon::Action::Open).setEnabled(false).onActivate([&] { quickOpen.run(); });
+  reindexAction.setText("Rebuild File Index").setIcon(Icon::Action::Refresh).setEnabled(false).onActivate([&] {
+    index.build(rootLocation);
+    workerStart();
+  });
+  saveAction.setText("Save").setIcon(Icon::Action::Save).onActivate([&] { documentSave(program, {documentActive()}); });
   saveAllAction.setText("Save All").setIcon(Icon::Action::Save).onActivate([&] {
-    for(auto document : documents) documentSave(program, document);
+    documentSave(program, loadedDocuments);  //written concurrently
   });
   quitAction.setText("Quit").setIcon(Icon::Action::Quit).onActivate([&] { close(); });
 
@@ -123,8 +632,12 @@ Program::Program() {
     findEdit.setText("");
     findLayout.setVisible(true);
     findEdit.setFocused();
+    findUpdate();
     layout.resize();
   });
+  findFilesAction.setText("Find in Files ...").setIcon(Icon::Action::Search).setEnabled(false).onActivate([&] {
+    findInFiles.run();
+  });
   gotoAction.setText("Goto").setIcon(Icon::Go::Right).onActivate([&] {
     findLayout.setVisible(false);
     gotoEdit.setText("");
@@ -134,24 +647,20 @@ Program::Program() {
   });
 
   helpMenu.setText("Help");
+  usageAction.setText("Memory Usage ...").setIcon(Icon::Prompt::Information).onActivate([&] { documentUsage(); });
   aboutAction.setText("About ...").setIcon(Icon::Prompt::Question).onActivate([&] { about(); });
 
-  menuBar.setFont(getFont("menu/font"));
-
-  layout.cell(treeView).setSize({getFloat("browser/width"), ~0});
+  layout.cell(treeView).setSize({settings.browser.width, ~0});
   treeView.setActivation(Mouse::Click::Single);
   treeView.setCollapsible();
-  treeView.setFont(getFont("browser/font"));
-  treeView.setBackgroundColor(getColor("browser/color/background"));
-  treeView.setForegroundColor(getColor("browser/color/standard"));
   treeView.onActivate([&] { documentActivate(); });
   treeView.onChange([&] { documentChange(); });
   treeView.onContext([&] {
     if(auto document = documentActive()) {
       newFolderAction.setEnabled(document->writable).setVisible(document->type == "folder");
       newFileAction.setEnabled(document->writable).setVisible(document->type == "folder");
-      renameDocumentAction.setEnabled(document->location && document->writable).setVisible(true);
-      removeDocumentAction.setEnabled(document->location && document->writable).setVisible(true);
+      renameDocumentAction.setEnabled(document->location() && document->writable).setVisible(true);
+      removeDocumentAction.setEnabled(document->location() && document->writable).setVisible(true);
       renameDocumentAction.setText(document->type == "folder" ? "Rename Folder ..." : "Rename File ...");
       removeDocumentAction.setText(document->type == "folder" ? "Remove Folder ..." : "Remove File ...");
     } else {
@@ -178,29 +687,38 @@ Program::Program() {
   });
 
   noDocument.setCollapsible();
-  noDocument.setBackgroundColor(getColor("editor/color/background"));
   noDocument.setEditable(false);
 
+  windowLayout.setCollapsible();
+  windowLayout.setVisible(false);
+  windowPreviousButton.setBordered(false).setIcon(Icon::Go::Up).onActivate([&] {
+    if(auto document = documentActive()) {
+      if(auto& large = document->large) documentWindow(document, large->windowLine - min(large->windowLine, (uint64_t)LargeFile::WindowLines));
+    }
+  });
+  windowNextButton.setBordered(false).setIcon(Icon::Go::Down).onActivate([&] {
+    if(auto document = documentActive()) {
+      if(auto& large = document->large) documentWindow(document, large->windowLine + large->windowLines);
+    }
+  });
+
   findLayout.setCollapsible();
   findLayout.setVisible(false);
-  findLabel.setText(" Find:").setFont(getFont("window/font"));
-  findEdit.setFont(getFont("find/font"));
-  findEdit.setBackgroundColor(getColor("find/color/background"));
-  findEdit.setForegroundColor(getColor("find/color/standard"));
-  findEdit.onActivate([&] { findNext(); });
+  findLabel.setText(" Find:");
+  findEdit.onActivate([&] { findNext(); }).onChange([&] { findChange(); });
+  findCaseOption.setText("Case").onToggle([&] { findChange(); });
+  findWordOption.setText("Words").onToggle([&] { findChange(); });
   findNextButton.setBordered(false).setIcon(Icon::Go::Down).onActivate([&] { findNext(); });
   findPreviousButton.setBordered(false).setIcon(Icon::Go::Up).onActivate([&] { findPrevious(); });
   findCloseButton.setBordered(false).setIcon(Icon::Action::Close).onActivate([&] {
     findLayout.setVisible(false);
+    findUpdate();
     layout.resize();
   });
 
   gotoLayout.setCollapsible();
   gotoLayout.setVisible(false);
-  gotoLabel.setText(" Goto:").setFont(getFont("window/font"));
-  gotoEdit.setFont(getFont("goto/font"));
-  gotoEdit.setBackgroundColor(getColor("goto/color/background"));
-  gotoEdit.setForegroundColor(getColor("goto/color/standard"));
+  gotoLabel.setText(" Goto:");
   gotoEdit.onActivate([&] { gotoLine(); });
   gotoLineButton.setBordered(false).setIcon(Icon::Go::Right).onActivate([&] { gotoLine(); });
   gotoCloseButton.setBordered(false).setIcon(Icon::Action::Close).onActivate([&] {
@@ -212,7 +730,7 @@ Program::Program() {
     auto location = rootLocation;
     if(auto document = documentActive()) {
       if(!document->treeViewItem.expanded()) treeView.doActivate();  //let the user know which names are already taken
-      location = document->location;
+      location = document->location();
     }
     if(auto name = NameDialog()
     .setIcon(Icon::Emblem::Folder)
@@ -238,7 +756,7 @@ Program::Program() {
     auto location = rootLocation;
     if(auto document = documentActive()) {
       if(!document->treeViewItem.expanded()) treeView.doActivate();  //let the user know which names are already taken
-      location = document->location;
+      location = document->location();
     }
     if(auto name = NameDialog()
     .setIcon(Icon::Emblem::File)
@@ -251,6 +769,7 @@ Program::Program() {
       if(!file::create({location, name})) {
         return (void)MessageDialog().setTitle("amethyst").setAlignment(program).setText("Failed to create file.").error();
       }
+      index.insert({location, name});
       if(auto parent = treeView.selected()) {
         append(parent, {location, name}).setSelected();
       } else {
@@ -269,9 +788,9 @@ Program::Program() {
       .setAlignment(*this)
       .rename(document->name())
       ) {
-        auto oldName = Location::base(document->location);
+        auto oldName = Location::base(document->location());
         if(newName == oldName) return;
-        auto location = Location::dir(document->location);
+        auto location = Location::dir(document->location());
         if(inode::exists({location, newName})) {
           return (void)MessageDialog().setTitle("amethyst").setAlignment(program).setText("Chosen name already exists.").error();
         }
@@ -280,7 +799,9 @@ Program::Program() {
           return (void)MessageDialog().setTitle("amethyst").setAlignment(program).setText({"Failed to rename ", type}).error();
         }
         if(document->type == "folder") newName.append("/");
+        auto oldLocation = document->location();
         document->rename(newName);
+        index.rename(oldLocation, document->location());
       }
     }
   });
@@ -294,22 +815,22 @@ Program::Program() {
       }).question() == "No") return;
       if(document->type == "folder") {
         if(!document->treeViewItem.expanded()) treeView.doActivate();  //show the user what will be deleted
-        if(!directory::remove(document->location)) {
+        if(!directory::remove(document->location())) {
           return (void)MessageDialog().setTitle("amethyst").setAlignment(program).setText("Failed to remove folder.").error();
         }
       } else {
-        if(!file::remove(document->location)) {
+        if(!file::remove(document->location())) {
           return (void)MessageDialog().setTitle("amethyst").setAlignment(program).setText("Failed to remove file.").error();
         }
       }
-      document->treeViewItem.remove();
-      if(auto index = documents.find(document)) documents.remove(index());
+      documentRemove(document);
     }
   });
 
   onClose([&] { close(); });
 
-  auto x = getFloat("window/x"), y = getFloat("window/y"), width = getFloat("window/width"), height = getFloat("window/height");
+  settingsApply();
+  auto x = settings.window.x, y = settings.window.y, width = settings.window.width, height = settings.window.height;
   auto workspace = Desktop::workspace();
   setFrameGeometry({
     x ? x : workspace.x(),
@@ -321,6 +842,7 @@ Program::Program() {
   Keyboard::append(Hotkey().setSequence("Escape").onPress([&] { if(program.focused()) {
     if(findLayout.visible()) {
       findLayout.setVisible(false);
+      findUpdate();
       layout.resize();
       if(auto document = documentActive()) document->sourceEdit.setFocused();
     }
@@ -335,14 +857,31 @@ Program::Program() {
     saveAction.doActivate();
   }}));
 
+  Keyboard::append(Hotkey().setSequence("Control+P").onPress([&] { if(program.focused()) {
+    if(openAction.enabled()) openAction.doActivate();
+  }}));
+
   Keyboard::append(Hotkey().setSequence("Control+F").onPress([&] { if(program.focused()) {
+    if(Keyboard::pressed("Shift")) return;  //Control+Shift+F
     findAction.doActivate();
   }}));
 
+  Keyboard::append(Hotkey().setSequence("Control+Shift+F").onPress([&] { if(program.focused()) {
+    if(findFilesAction.enabled()) findFilesAction.doActivate();
+  }}));
+
   Keyboard::append(Hotkey().setSequence("Control+G").onPress([&] { if(program.focused()) {
     gotoAction.doActivate();
   }}));
 
+  Keyboard::append(Hotkey().setSequence("Alt+PageUp").onPress([&] { if(program.focused()) {
+    if(windowLayout.visible() && windowPreviousButton.enabled()) windowPreviousButton.doActivate();
+  }}));
+
+  Keyboard::append(Hotkey().setSequence("Alt+PageDown").onPress([&] { if(program.focused()) {
+    if(windowLayout.visible() && windowNextButton.enabled()) windowNextButton.doActivate();
+  }}));
+
   Keyboard::append(Hotkey().setSequence("Control+Q").onPress([&] { if(program.focused()) {
     quitAction.doActivate();
   }}));
@@ -360,16 +899,37 @@ Program::Program() {
   keyboardPollTimer.setInterval(50).onActivate([&] {
     Keyboard::poll();
   });
+
+  //only used when the event loop cannot wait on workerWakeup itself, and only while there is work in flight
+  workerPollTimer.setInterval(16).onActivate([&] {
+    workerPoll();
+  });
+
+  //only used when the event loop cannot wait on the watcher itself
+  watchPollTimer.setInterval(1000).onActivate([&] {
+    watchPoll();
+  });
 }
 
 //if no files or a single file is loaded, hide the TreeView and give focus to the SourceEdit control
 //if a directory is loaded, show the TreeView and do not select any items (for delayed file loading)
 auto Program::main(Arguments arguments) -> void {
+  workerWatched = Application::watch(workerWakeup.descriptor(), [&] { workerPoll(); });
   if(arguments.size() == 1 && directory::exists(arguments[0])) {
-    scan(treeView, rootLocation = arguments[0]);
+    rootLocation = arguments[0];
+    if(!sessionLoad()) scan({}, rootLocation);
+    //the file index is only kept for folders: a single file or the home folder is not a project
+    if(!index.load(rootLocation)) {
+      index.build(rootLocation);
+      workerStart();
+    }
+    openAction.setEnabled();
+    reindexAction.setEnabled();
+    findFilesAction.setEnabled();
   } else {
     if(arguments.size() == 1 && file::exists(arguments[0])) {
       rootLocation = Location::dir(arguments[0]);
+      watcher.watch(rootLocation);
       append(treeView, arguments[0]).setSelected();
     } else {
       rootLocation = Path::user();
@@ -380,11 +940,22 @@ auto Program::main(Arguments arguments) -> void {
   }
   setTitle();
   setVisible();
-  keyboardPollTimer.setEnabled();
+  settingsLocation = locate("settings.bml");
+  settingsModified = file::timestamp(settingsLocation, file::time::modify);
+  settingsSize = file::size(settingsLocation);
+  watcher.watch(Location::dir(settingsLocation));  //watchPoll() reloads the settings when the file changes
+  if(Keyboard::polled()) keyboardPollTimer.setEnabled();  //only needed where key events do not update hotkeys
+  if(!Application::watch(watcher.descriptor(), [&] { watchPoll(); })) watchPollTimer.setEnabled();
   Application::run();
+  saveWait();
+  sessionSave();
+  scanReset();
+  findInFiles.reset();
+  index.save();
 }
 
 auto Program::close() -> void {
+  saveWait();  //the save dialog should only list documents that are still modified
   if(saveDialog.run()) Application::quit();
 }
 
@@ -396,21 +967,169 @@ auto Program::setTitle() -> void {
   }
 }
 
-template<typename T> auto Program::scan(T parent, string location) -> void {
-  for(auto& name : directory::contents(location)) {
-    append(parent, {location, name});
+//runs on a worker thread: only ScanJob::location, ScanJob::cancelled, the mutex-guarded fields and workerWakeup may be touched here
+//entries are sent as they are read, in no particular order: scanPoll() sorts the folder once the listing completes
+static auto scanWorker(uintptr parameter) -> void {
+  auto job = (ScanJob*)parameter;
+  vector<ScanJob::Entry> entries;
+  auto flush = [&](bool finished) {
+    {
+      lock_guard<mutex> guard(job->lock);
+      job->received.append(move(entries));
+      job->finished = finished;
+      entries.reset();
+    }
+    workerWakeup.signal();
+  };
+  directory::ucontents(job->location, [&](string name) -> bool {
+    if(job->cancelled) return false;
+    bool writable = inode::writable({job->location, name});
+    entries.append({move(name), writable});  //move rather than share the copy-on-write buffer across threads
+    if(entries.size() >= 256) flush(false);
+    return true;
+  });
+  flush(true);
+}
+
+auto scanPlaceholder(TreeViewItem item) -> TreeViewItem {
+  item.setText("scanning ...").setForegroundColor(settings.browser.readonly);
+  return item;
+}
+
+//list the contents of location on a worker thread; entries are appended to parent as they arrive
+//validate compares a folder restored from the session with the file system, without a placeholder
+auto Program::scan(shared_pointer<Document> parent, string location, bool validate) -> void {
+  shared_pointer<ScanJob> job{new ScanJob};
+  job->location = (const char*)location;
+  job->parent = parent;
+  job->validate = validate;
+  if(parent) {
+    for(auto& child : parent->children) job->existing.insert(child.key);
+    if(!validate) job->placeholder = scanPlaceholder(TreeViewItem{&parent->treeViewItem});
+  } else {
+    for(auto& child : documents) job->existing.insert(Location::base(child.key));
+    if(!validate) job->placeholder = scanPlaceholder(TreeViewItem{&treeView});
   }
+  job->worker = thread::create(scanWorker, (uintptr)job.data());
+  workerStart();
+  scanJobs.append(job);
+  watcher.watch(location);  //before the listing completes, so that nothing changed in between is missed
 }
 
-template<typename T> auto Program::append(T parent, string location) -> TreeViewItem {
+//drain entries received from the worker threads, a bounded number per wakeup to keep the GUI responsive
+auto Program::scanPoll() -> void {
+  uint budget = 512;
+  for(uint index = 0; index < scanJobs.size();) {
+    auto job = scanJobs[index];
+    bool finished = false;
+    {
+      lock_guard<mutex> guard(job->lock);
+      job->pending.append(move(job->received));
+      job->received.reset();
+      finished = job->finished;
+    }
+
+    auto parent = job->parent.acquire();
+    if(job->parent && !parent) job->cancelled = true;  //folder was removed while being scanned
+    if(!job->cancelled && job->pending && budget) {
+      uint count = min(budget, (uint)job->pending.size());
+      budget -= count;
+      job->placeholder.remove();
+      for(uint offset : range(count)) {
+        auto& entry = job->pending[offset];
+        if(job->validate) job->seen.insert(entry.name);
+        if(job->existing.find(entry.name)) continue;
+        if(parent) {
+          append(parent->treeViewItem, {parent->location(), entry.name}, entry.writable);
+        } else {
+          append(treeView, {rootLocation, entry.name}, entry.writable);
+        }
+      }
+      job->pending.removeLeft(count);
+      if(!job->validate && (!finished || job->pending)) {
+        job->placeholder = scanPlaceholder(parent ? TreeViewItem{&parent->treeViewItem} : TreeViewItem{&treeView});
+      }
+    }
+
+    if(finished && (job->cancelled || !job->pending)) {
+      job->placeholder.remove();
+      job->worker.join();
+      scanJobs.remove(index);
+      if(!job->parent) scanSort(treeView);
+      else if(parent) scanSort(parent->treeViewItem);
+      if(!job->cancelled && job->validate) {
+        vector<shared_pointer<Document>> removed;
+        for(auto& child : parent ? parent->children : documents) {
+          if(!job->seen.find(Location::base(child.key))) removed.append(child.value);
+        }
+        for(auto& document : removed) documentRemove(document);
+      }
+      if(!job->cancelled) for(auto& callback : job->onFinish) callback();
+      continue;
+    }
+    index++;
+  }
+  for(auto& job : scanJobs) {
+    if(!job->cancelled && job->pending) return workerWakeup.signal();  //continue with the entries left over
+  }
+}
+
+//folders first, then files, each by name; untitled documents stay last
+template<typename T> auto Program::scanSort(T parent) -> void {
+  auto name = [&](TreeViewItem item) -> string {
+    auto document = documentFind(item);
+    return document && document->segment ? Location::base(document->segment) : string{};
+  };
+  parent.sort([&](TreeViewItem lhs, TreeViewItem rhs) {
+    auto x = name(lhs), y = name(rhs);
+    if(!x || !y) return x && !y;
+    bool folderX = x.endsWith("/"), folderY = y.endsWith("/");
+    if(folderX != folderY) return folderX;
+    return x.trimRight("/", 1L) < y.trimRight("/", 1L);
+  });
+}
+
+//stop listing a folder; any entries already appended are kept, and the next scan will skip them
+auto Program::scanCancel(shared_pointer<Document> parent) -> bool {
+  bool cancelled = false;
+  for(auto& job : scanJobs) {
+    if(job->cancelled || job->parent.acquire() != parent) continue;
+    job->cancelled = true;
+    job->placeholder.remove();
+    cancelled = true;
+  }
+  return cancelled;
+}
+
+auto Program::scanActive(shared_pointer<Document> parent) -> shared_pointer<ScanJob> {
+  for(auto& job : scanJobs) {
+    if(!job->cancelled && job->parent.acquire() == parent) return job;
+  }
+  return {};
+}
+
+//wait for all worker threads to exit
+auto Program::scanReset() -> void {
+  for(auto& job : scanJobs) {
+    job->cancelled = true;
+    job->worker.join();
+  }
+  scanJobs.reset();
+}
+
+template<typename T> auto Program::append(T parent, string location, maybe<bool> writable) -> TreeViewItem {
   shared_pointer<Document> document{new Document};
-  document->location = location;
   TreeViewItem item{&parent};
   document->treeViewItem = item;
-  //note: this will leak a small amount of memory per document
-  //it is a workaround for hiro only supporting strings as Object properties
-  auto pointer = new shared_pointer_weak<Document>{document};
-  item.setAttribute("document", (uintptr)pointer);
+  if(auto folder = documentFind(parent)) {
+    document->parent = folder.data();
+    document->segment = Location::base(location);
+    folder->children.insert(document->segment, document);
+  } else {
+    document->segment = location;
+    documents.insert(location, document);
+  }
+  item.setAttribute<shared_pointer_weak<Document>>("document", shared_pointer_weak<Document>{document});
   if(location.endsWith("/")) {
     document->type = "folder";
   } else if(location) {
@@ -418,18 +1137,331 @@ template<typename T> auto Program::append(T parent, string location) -> TreeView
   } else {
     document->type = "text";
   }
-  document->writable = !location || inode::writable(location);
+  document->writable = !location || (writable ? writable() : inode::writable(location));
   document->update();
-  documents.append(document);
   return item;
 }
 
-template<typename T> auto Program::documentFind(T item) -> shared_pointer<Document> {
-  if(item) {
-    if(auto pointer = (shared_pointer_weak<Document>*)item.attribute("document").natural()) {
-      if(auto document = pointer->acquire()) return document;
+//collect the results that the worker threads signalled through workerWakeup
+//polls that leave work behind signal it again, to continue once the event loop has handled input and redraws
+auto Program::workerPoll() -> void {
+  if(workerWakeup.clear()) {
+    if(scanJobs) scanPoll();
+    if(sessionFolders || sessionDocuments) sessionPoll();
+    if(index.poll()) {
+      if(quickOpen.visible()) quickOpen.refresh();
+      if(findInFiles.deferred) findInFiles.search();
+    }
+    documentWindowUpdate();  //lines counted so far in large files
+    findInFiles.poll();
+    if(saveJobs) savePoll();  //last: it may show a dialog
+  }
+  if(!workerWatched && !workerBusy()) workerPollTimer.setEnabled(false);
+}
+
+//where the event loop cannot wait on workerWakeup, poll it from when a job starts until every job has finished
+auto Program::workerStart() -> void {
+  if(!workerWatched) workerPollTimer.setEnabled();
+}
+
+auto Program::workerBusy() -> bool {
+  if(scanJobs || saveJobs || sessionFolders || sessionDocuments || index.building()) return true;
+  if(findInFiles.job && findInFiles.job->workers) return true;
+  for(auto& document : loadedDocuments) {
+    if(document->large && !document->large->indexed()) return true;
+  }
+  return false;
+}
+
+//apply the changes reported by the file watcher to the TreeView and to the loaded documents
+auto Program::watchPoll() -> void {
+  //append location to its folder, if that folder has been listed
+  auto create = [&](const string& location) {
+    if(savePartials.find(location)) return;  //about to be renamed over the document being saved
+    if(!inode::exists(location)) return;     //already removed or renamed again
+    if(auto document = documentLocate(location)) return documentSync(document);  //already listed, or replaced
+    auto folder = Location::dir(location);
+    auto parent = documentLocate(folder);
+    if(parent && (parent->type != "folder" || !parent->loaded)) return;
+    if(!parent && (folder != rootLocation || !index.root)) return;  //only a folder argument lists rootLocation
+    if(auto job = scanActive(parent)) {
+      job->existing.insert(Location::base(location));
+      job->seen.insert(Location::base(location));
+    }
+    if(parent) append(parent->treeViewItem, location);
+    else append(treeView, location);
+    index.insert(location);
+  };
+  auto remove = [&](const string& location) {
+    auto document = documentLocate(location);
+    if(!document) return;
+    //keep unsaved changes: the user may still save them
+    if(document->type != "folder") {
+      if(!document->modified) return documentRemove(document);
+      document->desynced = true;
+      document->update();
+      return setTitle();
+    }
+    //a folder is dropped with everything beneath it, as the watcher no longer follows it;
+    //modified documents beneath it are listed on their own first, so that their changes are kept
+    for(auto& child : vector<shared_pointer<Document>>{loadedDocuments}) {
+      if(!child->modified || !child->parent || !child->location().beginsWith(location)) continue;
+      string path = child->location();
+      bool selected = child->treeViewItem.selected();
+      child->treeViewItem.remove();
+      child->parent->children.remove(child->segment);
+      child->parent = nullptr;
+      child->segment = path;
+      documents.insert(path, child);
+      child->treeViewItem = TreeViewItem{&treeView};
+      child->treeViewItem.setAttribute<shared_pointer_weak<Document>>("document", shared_pointer_weak<Document>{child});
+      child->desynced = true;
+      child->update();
+      if(selected) child->treeViewItem.setSelected();
+    }
+    documentRemove(document);
+    setTitle();
+  };
+
+  //the watcher lost events: compare every listed folder with the file system again, a few at a time as sessionPoll() does
+  auto rescan = [&] {
+    if(index.root && !scanActive({})) scan({}, rootLocation, true);
+    function<void (map<string, shared_pointer<Document>>&)> queue = [&](auto& documents) {
+      for(auto& node : documents) {
+        if(node.value->type != "folder" || !node.value->loaded) continue;
+        sessionFolders.append(node.value);
+        queue(node.value->children);
+      }
+    };
+    queue(documents);
+    for(auto& document : loadedDocuments) documentSync(document);
+    workerStart();
+    workerWakeup.signal();
+  };
+
+  bool settingsChanged = false;
+  bool overflowed = false;
+  for(auto& event : watcher.poll()) {
+    if(event.location == settingsLocation || event.previous == settingsLocation) settingsChanged = true;
+    if(event.action == file_watcher::action::overflow) overflowed = settingsChanged = true;
+    if(event.action == file_watcher::action::create) create(event.location);
+    if(event.action == file_watcher::action::remove) remove(event.location);
+    if(event.action == file_watcher::action::modify) {
+      if(auto document = documentLocate(event.location)) documentSync(document);
+    }
+    if(event.action == file_watcher::action::rename) {
+      auto document = documentLocate(event.previous);
+      if(document && Location::dir(event.previous) == Location::dir(event.location)) {
+        auto existing = documentLocate(event.location);
+        if(existing && existing != document) {
+          //renamed over another file, as programs that save through a temporary file do: keep the original document
+          documentRemove(document);
+          documentSync(existing);
+          continue;
+        }
+        document->rename(Location::base(event.location));
+        index.rename(event.previous, event.location);
+      } else {
+        remove(event.previous);
+        create(event.location);
+      }
+    }
+  }
+  if(overflowed) rescan();
+  if(!settingsLocation) return;
+  watcher.watch(Location::dir(settingsLocation));  //in case removing a listed folder stopped watching it
+  if(settingsChanged) settingsPoll();
+}
+
+auto Program::sessionLocation() const -> string {
+  return {Path::userSettings(), "amethyst/session-", hex(Hash::CRC32(rootLocation).value(), 8L), ".txt"};
+}
+
+//the session restores the TreeView of a folder as it was left, without listing any folder again
+//after rootLocation and the selected path, it holds one line per item, depth-first:
+//"<depth> <flags> <cursor offset> <cursor length> <address or window line> <name>"
+//flags: x = expanded, l = listed (its items follow), r = read-only, o = loaded, - = none
+auto Program::sessionLoad() -> bool {
+  auto data = string::read(sessionLocation());
+  const char* p = data.data();
+  const char* end = p + data.size();
+  auto line = [&]() -> string_view {
+    auto start = p;
+    while(p < end && *p != '\n') p++;
+    string_view view{start, uint(p - start)};
+    if(p < end) p++;
+    return view;
+  };
+  if(!rootLocation.equals(line())) return false;
+  string selected = line();
+  vector<shared_pointer<Document>> folders;  //listed folder at each depth
+  while(p < end) {
+    auto fields = string{line()}.split(" ", 5L);
+    if(fields.size() != 6) break;
+    uint depth = fields[0].natural();
+    auto& flags = fields[1];
+    auto& name = fields[5];
+    if(depth > folders.size() || !name) break;  //the rest is damaged: validation will list what is missing
+    folders.resize(depth);
+    auto parent = depth ? folders.last() : shared_pointer<Document>{};
+    auto item = parent ? append(parent->treeViewItem, {parent->location(), name}, !flags.find("r")) : append(treeView, {rootLocation, name}, !flags.find("r"));
+    auto document = documentFind(item);
+    document->cursor = TextCursor{(int)fields[2].integer(), (int)fields[3].integer()};
+    if(document->type == "binary") document->address = fields[4].natural();
+    if(document->type == "text") document->windowLine = fields[4].natural();
+    if(document->type == "folder" && flags.find("l")) {
+      document->loaded = true;
+      watcher.watch(document->location());
+      sessionFolders.append(document);
+      folders.append(document);
+      if(flags.find("x")) item.setExpanded(true);
     }
+    if(document->type != "folder" && flags.find("o")) sessionDocuments.append(document);
+    document->update();
+  }
+  scan({}, rootLocation, true);
+  if(selected) {
+    if(auto document = documentLocate({rootLocation, selected})) {
+      document->treeViewItem.setSelected();
+      documentChange();
+    }
+  }
+  workerWakeup.signal();  //sessionPoll() starts the background work
+  workerStart();
+  return true;
+}
+
+auto Program::sessionSave() -> void {
+  if(!index.root) return;  //only folders given as the argument have a session
+  if(scanActive({})) return (void)file::remove(sessionLocation());  //rootLocation was not listed in full
+  string data{rootLocation, "\n"};
+  auto active = documentActive();
+  data.append(active ? string{active->location()}.trimLeft(rootLocation, 1L) : string{}, "\n");
+  function<void (vector<TreeViewItem>, uint)> save = [&](vector<TreeViewItem> items, uint depth) {
+    for(auto& item : items) {
+      auto document = documentFind(item);
+      if(!document) continue;  //"scanning ..." placeholder
+      bool listed = document->type == "folder" && document->loaded && !scanActive(document);
+      string flags;
+      if(listed && item.expanded()) flags.append("x");
+      if(listed) flags.append("l");
+      if(!document->writable) flags.append("r");
+      if(document->type != "folder" && document->loaded) flags.append("o");
+      if(!flags) flags = "-";
+      auto cursor = document->cursor;
+      uint64_t position = document->type == "binary" ? document->address : document->windowLine;
+      if(document->loaded && document->type == "text") {
+        cursor = document->sourceEdit.textCursor();
+        if(document->large) position = document->large->windowLine;
+      }
+      if(document->loaded && document->type == "binary") position = document->hexEdit.address();
+      string name = document->parent ? document->segment : Location::base(document->segment);
+      data.append(depth, " ", flags, " ", cursor.offset(), " ", cursor.length(), " ", position, " ", name, "\n");
+      if(listed) save(item.items(), depth + 1);
+    }
+  };
+  save(treeView.items(), 0);
+  directory::create({Path::userSettings(), "amethyst/"});
+  file::replace(sessionLocation(), data);
+}
+
+//compare a few restored (or, after the watcher lost events, listed) folders at a time with the file system, and reload one of the documents left open per wakeup
+//folders are taken as earlier scans complete, which signals workerWakeup; documents continue by signalling it again
+auto Program::sessionPoll() -> void {
+  while(sessionFolders && scanJobs.size() < 4) {
+    auto document = sessionFolders.takeLeft().acquire();
+    if(document && document->loaded && !scanActive(document)) scan(document, document->location(), true);
   }
+  if(sessionDocuments) {
+    auto document = sessionDocuments.takeLeft().acquire();
+    if(document && !document->loaded && documentLoad(document)) documentEvict();
+  }
+  if(sessionDocuments) workerWakeup.signal();
+}
+
+//settings.bml may be edited while the program runs: watchPoll() calls this whenever the file watcher reports it,
+//and every window is restyled once it has changed
+//the size is compared as well, since a second write within the same second keeps the timestamp
+auto Program::settingsPoll() -> void {
+  auto& location = settingsLocation;
+  auto modified = file::timestamp(location, file::time::modify);
+  auto size = file::size(location);
+  if(modified == settingsModified && size == settingsSize) return;
+  //an empty document means the file is missing, or part way through being written: keep the current settings,
+  //and read it again when the write completes
+  auto document = BML::unserialize(file::read(location));
+  if(!document) return;
+  Settings loaded;
+  loaded.load(document);
+  settings = loaded;
+  settingsModified = modified;
+  settingsSize = size;
+  settingsApply();
+  saveDialog.settingsApply();
+  quickOpen.settingsApply();
+  findInFiles.settingsApply();
+  documentEvict();  //the budget may have been lowered
+}
+
+//the window geometry and browser width are only read at startup, since the user may have changed them since
+auto Program::settingsApply() -> void {
+  menuBar.setFont(settings.menu.font);
+  treeView.setFont(settings.browser.font);
+  treeView.setBackgroundColor(settings.browser.background);
+  treeView.setForegroundColor(settings.browser.standard);
+  noDocument.setBackgroundColor(settings.editor.background);
+  windowLabel.setFont(settings.window.font);
+  findLabel.setFont(settings.window.font);
+  findEdit.setFont(settings.find.font);
+  findEdit.setBackgroundColor(settings.find.background);
+  findEdit.setForegroundColor(settings.find.standard);
+  findCountLabel.setFont(settings.window.font);
+  findCaseOption.setFont(settings.window.font);
+  findWordOption.setFont(settings.window.font);
+  gotoLabel.setFont(settings.window.font);
+  gotoEdit.setFont(settings.jump.font);
+  gotoEdit.setBackgroundColor(settings.jump.background);
+  gotoEdit.setForegroundColor(settings.jump.standard);
+
+  function<void (map<string, shared_pointer<Document>>&)> update = [&](auto& documents) {
+    for(auto& node : documents) {
+      node.value->update();
+      update(node.value->children);
+    }
+  };
+  update(documents);
+  for(auto& document : loadedDocuments) {
+    if(document->type == "binary") {
+      document->hexEdit.setFont(settings.editor.font);
+      document->hexEdit.setBackgroundColor(settings.editor.background);
+      document->hexEdit.setForegroundColor(settings.editor.standard);
+      document->hexEdit.doSize();
+    } else {
+      document->sourceEdit.setFont(settings.editor.font);
+      document->sourceEdit.setScheme(settings.editor.scheme);
+    }
+  }
+}
+
+//follows location one folder at a time from the documents listed directly in the TreeView
+auto Program::documentLocate(const string& location) -> shared_pointer<Document> {
+  if(auto document = documents.find(location)) return document();
+  if(!location.beginsWith(rootLocation)) return {};
+  shared_pointer<Document> document;
+  for(uint lower = rootLocation.size(); lower < location.size();) {
+    uint upper = lower;
+    while(upper < location.size() && location[upper] != '/') upper++;
+    if(upper < location.size()) upper++;  //folder segments keep their trailing "/"
+    auto child = document ? document->children.find(location.slice(lower, upper - lower)) : documents.find(location.slice(0, upper));
+    if(!child) return {};
+    document = child();
+    lower = upper;
+  }
+  return document;
+}
+
+template<typename T> auto Program::documentFind(T item) -> shared_pointer<Document> {
+  if(item) return item.template attribute<shared_pointer_weak<Document>>("document").acquire();
   return {};
 }
 
@@ -441,9 +1473,12 @@ auto Program::documentActivate() -> void {
   if(auto item = treeView.selected()) {
     if(auto document = documentFind(item)) {
       if(document->type == "folder") {
-        if(!document->loaded) {
+        if(item.expanded()) {
+          //collapsing a folder that is still being scanned abandons the scan: resume it on the next expansion
+          if(scanCancel(document)) document->loaded = false;
+        } else if(!document->loaded) {
           document->loaded = true;
-          scan(document->treeViewItem, document->location);
+          scan(document, document->location());
         }
         item.setExpanded(!item.expanded());
         document->update();
@@ -454,59 +1489,256 @@ auto Program::documentActivate() -> void {
 
 auto Program::documentChange() -> void {
   noDocument->setVisible(true);
-  //at this point, the previously selected TreeView item (document) has lost focus ...
-  //since it is unknown since document was active, ensure that every document is hidden instead
-  for(auto document : documents) {
+  //at this point, the previously selected TreeView item (document) has lost focus: hide its editor
+  if(auto document = shownDocument) {
     if(document->sourceEdit.visible()) document->sourceEdit.setVisible(false);
+    if(document->hexEdit.visible()) document->hexEdit.setVisible(false);
+    if(document->sourceEdit.search()) document->sourceEdit.setSearch();  //only the active document is highlighted
+    shownDocument.reset();
   }
 
   if(auto item = treeView.selected()) {
     auto document = documentFind(item);
     if(document && document->type != "folder") {
       if(!document->loaded) {
-        //do not load files that are so large they would hang the editor for a long time ...
-        if(file::size(document->location) >= 64 * 1024 * 1024) return;
-        document->loaded = true;
-        document->timestamp = file::timestamp(document->location, file::time::modify);
-        document->writable = !document->location || file::writable(document->location);
-        document->sourceEdit.onChange([&] { documentModify(); });
-        document->sourceEdit.setCollapsible();
-        document->sourceEdit.setFont(getFont("editor/font"));
-        document->sourceEdit.setWordWrap(false);
-        document->sourceEdit.setLanguage(document->language());
-        document->sourceEdit.setScheme(getString("editor/scheme"));
-        if(document->type == "text") {
-          document->sourceEdit.setNumbered(true);
-          document->sourceEdit.setText(file::read(document->location));
-          document->sourceEdit.setEditable(document->writable);
-        } else {
-          document->sourceEdit.setNumbered(false);
-          document->sourceEdit.setText(documentBinary(document->location));
-          document->sourceEdit.setEditable(false);
-        }
-        documentLayout.append(document->sourceEdit, Size{~0, ~0});
-        document->sourceEdit.setTextCursor();
-        document->update();  //writable property may have changed since parent directory was scanned
-      } else if(file::timestamp(document->location, file::time::modify) > document->timestamp) {
-        //file has been modified externally since it was last selected ...
-        document->desynced = true;
-        document->update();
-        setTitle();
+        if(!documentLoad(document)) return;
+      } else if(!watcher.watching(Location::dir(document->location()))) {
+        documentSync(document);  //watched documents are synchronized as soon as they change
+      }
+      if(document->type == "binary") {
+        document->hexEdit.setVisible(true);
+      } else {
+        document->sourceEdit.setVisible(true);
       }
-      document->sourceEdit.setVisible(true);
       noDocument->setVisible(false);
+      shownDocument = document;
+      document->used = ++documentsShown;
+      documentEvict();
     }
   }
 
   setTitle();
+  documentWindowUpdate();
+  findUpdate();
   layout.resize();
   //todo: somehow, this prevents a brief flickering when changing documents for the first time,
   //where the window color (usually bright gray) paints in place of the SourceEdit control
   Application::processEvents();
 }
 
+//create the editor of a document, and fill it with the contents of its file
+auto Program::documentLoad(shared_pointer<Document> document) -> bool {
+  string text;
+  bool valid = true;
+  //binary files, and text files too large to load at once, are memory-mapped
+  if(document->type == "binary") {
+    if(!document->map.open(document->location(), file_map::mode::read)) return false;
+  } else if(file::size(document->location()) >= LargeFile::Threshold) {
+    document->large = new LargeFile;
+    if(!document->large->open(document->location())) return document->large.reset(), false;
+    workerStart();
+    text = document->large->setWindow(document->windowLine);
+    valid = document->large->windowOffsets.valid();
+  } else {
+    text = file::read(document->location());
+    valid = UTF8::valid(text.data(), text.size());
+  }
+  //the SourceEdit rejects text that is not valid UTF-8: show it as binary instead
+  if(!valid) {
+    document->large.reset();
+    document->type = "binary";
+    document->update();
+    if(!document->map.open(document->location(), file_map::mode::read)) return false;
+  }
+  document->loaded = true;
+  document->desynced = false;  //an unloaded document is read again in full
+  document->timestamp = file::timestamp(document->location(), file::time::modify);
+  document->size = file::size(document->location());
+  document->writable = !document->location() || file::writable(document->location());
+  if(document->type == "binary") {
+    documentBinary(document);
+    document->hexEdit.setAddress(document->address).update();
+    document->hexEdit.setVisible(false);  //until documentChange() shows it
+    documentLayout.append(document->hexEdit, Size{~0, ~0});
+    //the mapping is backed by the file, so the system can reclaim it: only the widget is counted
+    document->resident = 64 * 1024;
+  } else {
+    document->sourceEdit.onChange([&] { documentModify(); });
+    document->sourceEdit.onSearch([&] { findCount(); });
+    document->sourceEdit.setCollapsible();
+    document->sourceEdit.setFont(settings.editor.font);
+    document->sourceEdit.setWordWrap(false);
+    document->sourceEdit.setLanguage(document->language());
+    document->sourceEdit.setScheme(settings.editor.scheme);
+    if(document->large) {
+      document->sourceEdit.setNumbered(false);  //numbers would restart at 1 in every window
+      document->sourceEdit.setText(text);
+      document->sourceEdit.setEditable(false);
+    } else {
+      document->sourceEdit.setNumbered(true);
+      document->sourceEdit.setText(text);
+      document->sourceEdit.setEditable(document->writable);
+    }
+    document->sourceEdit.setVisible(false);
+    documentLayout.append(document->sourceEdit, Size{~0, ~0});
+    document->sourceEdit.setTextCursor(document->cursor);
+    //the text buffer holds the text, about as much again in highlighting tags, and a node per line
+    document->resident = text.size() * 2 + document->sourceEdit.lineCount() * 64;
+  }
+  document->update();  //writable property may have changed since parent directory was scanned
+  loadedDocuments.append(document);
+  return true;
+}
+
+//release the editor of a document, keeping its position so that it can be loaded again when next shown
+auto Program::documentUnload(shared_pointer<Document> document) -> void {
+  if(!document->loaded || document->type == "folder" || document->modified || document->saving) return;
+  if(document == shownDocument) return;
+  if(document->type == "binary") {
+    document->address = document->hexEdit.address();
+    documentLayout.remove(document->hexEdit);
+    document->hexEdit = HexEdit{};
+    document->map.close();
+  } else {
+    document->cursor = document->sourceEdit.textCursor();
+    if(document->large) document->windowLine = document->large->windowLine;
+    documentLayout.remove(document->sourceEdit);
+    document->sourceEdit = SourceEdit{};
+    document->large.reset();
+  }
+  document->resident = 0;
+  document->loaded = false;
+  loadedDocuments.removeByValue(document);
+}
+
+//unload the least recently shown documents until the loaded ones fit within editor/budget (in MiB)
+//the active document and documents with unsaved changes are never unloaded
+auto Program::documentEvict() -> void {
+  uint64_t budget = settings.editor.budget * 1024 * 1024;
+  if(!budget) return;  //no budget: documents stay loaded once shown
+  auto active = documentActive();
+  uint64_t resident = 0;
+  vector<shared_pointer<Document>> candidates;
+  for(auto& document : loadedDocuments) {
+    resident += document->resident;
+    if(document != active && document->location() && !document->modified) candidates.append(document);
+  }
+  if(resident <= budget) return;
+  candidates.sort([](auto& lhs, auto& rhs) { return lhs->used < rhs->used; });
+  for(auto& document : candidates) {
+    if(resident <= budget) break;
+    resident -= document->resident;
+    documentUnload(document);
+  }
+}
+
+//lists the loaded documents and their estimated memory use, largest first
+auto Program::documentUsage() -> void {
+  auto kilobytes = [](uint64_t bytes) { return pad((bytes + 1023) / 1024, 9); };
+  auto loaded = loadedDocuments;
+  uint64_t resident = 0;
+  for(auto& document : loaded) resident += document->resident;
+  loaded.sort([](auto& lhs, auto& rhs) { return lhs->resident > rhs->resident; });
+  auto budget = settings.editor.budget;
+  string text{
+    "Budget: ", budget ? string{budget, " MiB"} : string{"unlimited"}, "\n",
+    "Loaded: ", loaded.size(), " documents, ", (resident + 1023) / 1024, " KiB\n"
+  };
+  for(uint n : range(min(20u, (uint)loaded.size()))) {
+    text.append("\n", kilobytes(loaded[n]->resident), " KiB  ", loaded[n]->title());
+  }
+  if(loaded.size() > 20) text.append("\n... and ", loaded.size() - 20, " more");
+  MessageDialog().setTitle("amethyst").setAlignment(program).setText(text).information();
+}
+
+//select location in the TreeView, expanding (and if need be, scanning) each of its parent folders in turn
+//line, column and length select a range in the document once it is loaded
+auto Program::documentReveal(string location, uint line, uint column, uint length) -> void {
+  if(!location.beginsWith(rootLocation)) return;
+  auto parts = string{location}.trimLeft(rootLocation, 1L).split("/");
+  shared_pointer<Document> folder;
+  string path = rootLocation;
+  for(uint index : range(parts.size())) {
+    bool last = index + 1 == parts.size();
+    path.append(parts[index], last ? "" : "/");
+    if(auto job = scanActive(folder)) {
+      //the folder is still being listed: start over once it has been
+      return job->onFinish.append([=] { documentReveal(location, line, column, length); });
+    }
+    shared_pointer<Document> child;
+    if(auto document = folder ? folder->children.find(Location::base(path)) : documents.find(path)) child = document();
+    if(!child) return;  //removed since it was indexed
+    if(last) {
+      child->treeViewItem.setSelected();
+      treeView.doChange();
+      if(line) documentGoto(child, line, column, length);
+      return;
+    }
+    if(!child->treeViewItem.expanded()) {
+      if(!child->loaded) {
+        child->loaded = true;
+        scan(child, child->location());
+      }
+      child->treeViewItem.setExpanded(true);
+      child->update();
+    }
+    folder = child;
+  }
+}
+
+//called when a file may have been modified externally since it was loaded
+auto Program::documentSync(shared_pointer<Document> document) -> void {
+  if(!document->loaded || document->type == "folder" || document->saving) return;  //savePoll() takes the new timestamp
+  auto timestamp = file::timestamp(document->location(), file::time::modify);
+  auto size = file::size(document->location());
+  if(document->type == "binary") {
+    //binary documents cannot be modified, so simply map the file again on every change:
+    //the file may have been replaced by another one of the same size within the same second
+    document->map.open(document->location(), file_map::mode::read);
+    document->timestamp = timestamp;
+    document->size = size;
+    document->hexEdit.setLength(document->map.size()).update();
+  } else if(timestamp == document->timestamp && size == document->size) {
+    return;
+  } else if(!document->desynced) {
+    document->desynced = true;
+    document->update();
+    if(document == documentActive()) setTitle();
+  }
+}
+
+//forget a document that no longer exists, along with everything beneath it
+auto Program::documentRemove(shared_pointer<Document> document) -> void {
+  auto location = document->location();
+  if(document->type == "folder") watcher.unwatch(location);
+  index.remove(location);
+  document->treeViewItem.remove();
+  documentDetach(document);
+  auto& siblings = document->parent ? document->parent->children : documents;
+  siblings.remove(document->segment);
+  document->segment = location;  //in case it is still referenced: its parent may be released
+  document->parent = nullptr;
+}
+
+//release the editors and scans of a removed document and everything beneath it
+auto Program::documentDetach(shared_pointer<Document> document) -> void {
+  for(auto& child : document->children) {
+    documentDetach(child.value);
+    child.value->segment = child.value->location();
+    child.value->parent = nullptr;
+  }
+  document->children.reset();
+  scanCancel(document);
+  if(document->type != "folder" && document->loaded) {
+    documentLayout.remove(document->type == "binary" ? (sSizable)document->hexEdit : (sSizable)document->sourceEdit);
+    loadedDocuments.removeByValue(document);
+  }
+  if(document == shownDocument) shownDocument.reset(), noDocument.setVisible(true);
+}
+
 auto Program::documentModify() -> void {
   if(auto document = documentActive()) {
+    document->revision++;
     if(!document->modified) {
       document->modified = true;
       document->update();
@@ -515,148 +1747,378 @@ auto Program::documentModify() -> void {
   }
 }
 
-auto Program::documentSave(Window parent, shared_pointer<Document> document) -> void {
-  if(!document || !document->modified) return;
-  if(!document->location) {
-    document->location = BrowserDialog().setAlignment(parent).saveFile();
-    if(!document->location) return;
-  } else {
-    auto timestamp = file::timestamp(document->location, file::time::modify);
-    if(timestamp > document->timestamp) {
-      if(MessageDialog().setAlignment(parent).setTitle("amethyst").setText({
-        "File modified externally since opening. Save anyway?\n\n",
-        document->title()
-      }).warning({"Yes", "No"}) == "No") return;
+//the temporary file that file::replace() writes for location, as the file watcher may report it:
+//beside the file a symbolic link refers to, seen through the document's folder or through its resolved folder
+static auto savePartial(const string& location) -> vector<string> {
+  auto partial = file::partial(location);
+  return {partial, string{Location::dir(location), Location::base(partial)}};
+}
+
+//runs on a worker thread: only the entries claimed through SaveJob::next, the mutex-guarded fields and workerWakeup may be touched here
+static auto saveWorker(uintptr parameter) -> void {
+  auto job = (SaveJob*)parameter;
+  for(uint index = job->next++; index < job->entries.size(); index = job->next++) {
+    auto& entry = job->entries[index];
+    entry.saved = file::replace(entry.location, entry.text);
+    {
+      lock_guard<mutex> guard(job->lock);
+      job->finished.append(index);
     }
+    workerWakeup.signal();
   }
-  if(!file::write(document->location, document->sourceEdit.text())) {
-    MessageDialog().setAlignment(parent).setTitle("amethyst").setText({
-      "Failed to save file. Perhaps file permissions changed after loading.\n\n",
-      document->title()
-    }).error();
-    return;
+  {
+    lock_guard<mutex> guard(job->lock);
+    job->running--;
   }
-  document->timestamp = file::timestamp(document->location, file::time::modify);
-  document->modified = false;
-  document->desynced = false;
-  document->update();
-  if(document == documentActive()) setTitle();
+  workerWakeup.signal();
 }
 
-auto Program::documentBinary(string location) -> string {
-  string output;
-  auto data = file::read(location);
-  uint offset = 0;
-  do {
-    output.append(hex(offset, 8L), "  ");
-    for(uint index : range(16)) {
-      if(offset + index < data.size()) {
-        output.append(hex(data[offset + index], 2L), " ");
-      } else {
-        output.append("   ");
+//confirm each modified document with the user, then write their contents on worker threads
+//documents stay modified until savePoll() learns that they have been written
+auto Program::documentSave(Window parent, vector<shared_pointer<Document>> documents) -> void {
+  shared_pointer<SaveJob> job{new SaveJob};
+  for(auto& document : documents) {
+    if(!document || !document->modified) continue;
+    if(document->saving) { document->saveQueued = true; continue; }  //savePoll() saves it again with the later edits
+    if(!document->location()) {
+      auto location = BrowserDialog().setAlignment(parent).saveFile();
+      if(!location) continue;
+      document->relink(location);  //only untitled documents have no location, and they have no parent
+    } else {
+      auto timestamp = file::timestamp(document->location(), file::time::modify);
+      if(timestamp != document->timestamp || file::size(document->location()) != document->size) {
+        if(MessageDialog().setAlignment(parent).setTitle("amethyst").setText({
+          "File modified externally since opening. Save anyway?\n\n",
+          document->title()
+        }).warning({"Yes", "No"}) == "No") continue;
       }
     }
-    output.append(" ");
-    for(uint index : range(16)) {
-      if(offset + index < data.size()) {
-        char byte = data[offset + index];
-        output.append(byte >= 0x20 && byte <= 0x7e ? byte : '.');
-      } else {
-        output.append(" ");
+    SaveJob::Entry entry;
+    entry.document = document;
+    entry.revision = document->revision;
+    entry.location = (const char*)document->location();
+    entry.text = string{string_view{document->sourceEdit.text()}};  //deep copy
+    job->entries.append(move(entry));
+    for(auto& partial : savePartial(document->location())) savePartials.insert(partial);
+    document->saving = true;
+  }
+  if(!job->entries) return;
+  uint count = max(1u, min(thread::concurrency(), (uint)job->entries.size()));
+  job->running = count;
+  for(uint n : range(count)) job->workers.append(thread::create(saveWorker, (uintptr)job.data()));
+  workerStart();
+  saveJobs.append(job);
+}
+
+//update each document as its save completes, and report the documents that could not be written
+//returns false if any could not be
+auto Program::savePoll() -> bool {
+  vector<string> failures;
+  vector<shared_pointer<Document>> queued;
+  for(uint index = 0; index < saveJobs.size();) {
+    auto job = saveJobs[index];
+    vector<uint> finished;
+    bool running = true;
+    {
+      lock_guard<mutex> guard(job->lock);
+      finished = move(job->finished);
+      job->finished.reset();
+      running = job->running > 0;
+    }
+    for(uint offset : finished) {
+      auto& entry = job->entries[offset];
+      for(auto& partial : savePartial(entry.location)) savePartials.remove(partial);
+      auto document = entry.document.acquire();
+      if(!document) continue;  //removed while it was being written
+      document->saving = false;
+      bool saveQueued = document->saveQueued;
+      document->saveQueued = false;
+      if(!entry.saved) {
+        failures.append(document->title());
+        continue;
       }
+      document->timestamp = file::timestamp(document->location(), file::time::modify);
+      document->size = file::size(document->location());
+      if(document->revision == entry.revision) document->modified = false;
+      document->desynced = false;
+      document->update();
+      if(document == documentActive()) setTitle();
+      if(saveQueued && document->modified) queued.append(document);
+    }
+    if(!running) {
+      for(auto& worker : job->workers) worker.join();
+      saveJobs.remove(index);
+      continue;
+    }
+    index++;
+  }
+  if(queued) documentSave(program, queued);
+  if(failures) {
+    MessageDialog().setAlignment(program).setTitle("amethyst").setText({
+      "Failed to save ", failures.size() == 1 ? "file" : "files", ". Perhaps file permissions changed after loading.\n\n",
+      failures.merge("\n")
+    }).error();
+  }
+  return !failures;
+}
+
+//block until every pending save has been written, including those queued while an earlier save was running
+auto Program::saveWait() -> bool {
+  bool saved = true;
+  do {
+    for(auto& job : saveJobs) {
+      for(auto& worker : job->workers) worker.join();
+      job->workers.reset();
     }
-    output.append("\n");
-    offset += 16;
-  } while(offset < data.size());
-  return output;
+    saved &= savePoll();
+  } while(saveJobs);
+  return saved;
 }
 
-//note: GTK SourceEdit::Cursor takes UTF-8 character indexes;
-//nall/string functions use uint8_t indexes.
-//use string::characters() to convert utf8_t to UTF-8 indexes below
+//binary documents are shown as a hex dump; only the rows that are visible are ever formatted
+auto Program::documentBinary(shared_pointer<Document> document) -> void {
+  auto map = &document->map;
+  auto hexEdit = &document->hexEdit;
+  hexEdit->setCollapsible();
+  hexEdit->setFont(settings.editor.font);
+  hexEdit->setBackgroundColor(settings.editor.background);
+  hexEdit->setForegroundColor(settings.editor.standard);
+  hexEdit->setLength(map->size());
+  hexEdit->onRead([map](uint64_t address) -> uint8_t {
+    uint8_t data = 0x00;
+    //the file may be truncated before documentSync() maps it again
+    if(address < map->size()) file_map::guard([&] { data = map->data()[address]; });
+    return data;
+  });
+  hexEdit->onSize([hexEdit] {
+    //show as many rows as will fit
+    float height = settings.editor.font.size(" ").height();
+    uint rows = max(1.0f, (hexEdit->geometry().height() - 8) / max(1.0f, height));
+    if(hexEdit->rows() != rows) hexEdit->setRows(rows).update();
+  });
+  hexEdit->update();
+}
+
+//show the lines of a large file beginning at line
+//returns false if the window is not valid UTF-8: the document is then shown as binary, at the window's offset
+auto Program::documentWindow(shared_pointer<Document> document, uint64_t line) -> bool {
+  if(!document || !document->large) return false;
+  auto text = document->large->setWindow(line);
+  if(!document->large->windowOffsets.valid()) {
+    //the SourceEdit rejects text that is not valid UTF-8, as documentLoad() does for the first window
+    document->address = document->large->windowStart;
+    documentLayout.remove(document->sourceEdit);
+    document->sourceEdit = SourceEdit{};
+    document->large.reset();
+    document->resident = 0;
+    document->loaded = false;
+    loadedDocuments.removeByValue(document);
+    document->type = "binary";
+    document->update();
+    if(document == shownDocument) documentChange();
+    return false;
+  }
+  document->sourceEdit.setText(text);
+  document->sourceEdit.setTextCursor();
+  documentWindowUpdate();
+  return true;
+}
+
+//show which lines of a large file are in the SourceEdit, or hide the window bar for other documents
+auto Program::documentWindowUpdate() -> void {
+  auto document = documentActive();
+  bool visible = document && document->large && document->loaded;
+  if(windowLayout.visible() != visible) {
+    windowLayout.setVisible(visible);
+    layout.resize();
+  }
+  if(!visible) return;
+  auto& large = document->large;
+  string text{" Lines ", large->windowLine + 1, "-", large->windowLine + large->windowLines, " of "};
+  if(large->indexed()) {
+    text.append(large->lineCount());
+  } else {
+    text.append("at least ", large->lineCount(), " (indexing ...)");
+  }
+  windowLabel.setText(text);
+  windowPreviousButton.setEnabled(large->windowLine > 0);
+  windowNextButton.setEnabled(large->windowEnd < large->map.size());
+}
+
+//applies the find bar to the active document, whose SourceEdit highlights and counts every match
+auto Program::findUpdate() -> void {
+  auto document = documentActive();
+  if(document && document->type == "text" && document->loaded) {
+    auto& sourceEdit = document->sourceEdit;
+    auto search = findLayout.visible() ? findEdit.text() : string{};
+    if(sourceEdit.searchCase() != findCaseOption.checked()) sourceEdit.setSearchCase(findCaseOption.checked());
+    if(sourceEdit.searchWholeWord() != findWordOption.checked()) sourceEdit.setSearchWholeWord(findWordOption.checked());
+    if(sourceEdit.search() != search) sourceEdit.setSearch(search);
+  }
+  findCount();
+}
+
+//search as you type: select the first match at or after the start of the selection
+auto Program::findChange() -> void {
+  findUpdate();
+  auto document = documentActive();
+  if(!document || document->type != "text" || !document->loaded) return;
+  auto& sourceEdit = document->sourceEdit;
+  auto cursor = sourceEdit.textCursor();
+  sourceEdit.setTextCursor(cursor.offset());
+  if(!sourceEdit.searchNext()) sourceEdit.setTextCursor(cursor);
+}
+
+auto Program::findCount() -> void {
+  string text;
+  auto document = documentActive();
+  if(findLayout.visible() && document && document->type == "text" && document->sourceEdit.search()) {
+    int count = document->sourceEdit.searchCount();
+    if(count < 0) text = "Searching ...";
+    else if(count == 0) text = "No matches";
+    else text = {count, count == 1 ? " match" : " matches"};
+  }
+  if(findCountLabel.text() == text) return;
+  findCountLabel.setText(text);
+  layout.resize();
+}
 
 auto Program::findNext() -> void {
   if(!findEdit.text()) return;
   if(auto document = documentActive()) {
-    auto search = findEdit.text();
-    auto text = document->sourceEdit.text();
-    auto cursor = document->sourceEdit.textCursor();
-    if(auto match = text.findNext(cursor.offset(), search)) {
-      int offset = text.characters(0, match());
-      int length = search.characters();
-      document->sourceEdit.setTextCursor({offset, length});
-    } else if(match = text.find(search)) {
-      int offset = text.characters(0, match());
-      int length = search.characters();
-      document->sourceEdit.setTextCursor({offset, length});
-    }
+    if(document->large) return findLarge(document, true);
+    findUpdate();
+    document->sourceEdit.searchNext();
   }
 }
 
 auto Program::findPrevious() -> void {
   if(!findEdit.text()) return;
   if(auto document = documentActive()) {
-    auto search = findEdit.text();
-    auto text = document->sourceEdit.text();
-    auto cursor = document->sourceEdit.textCursor();
-    if(auto match = text.findPrevious(cursor.offset(), search)) {
-      int offset = text.characters(0, match());
-      int length = search.characters();
-      document->sourceEdit.setTextCursor({offset, length});
-    } else if(match = text.findPrevious(text.size(), search)) {
-      int offset = text.characters(0, match());
-      int length = search.characters();
-      document->sourceEdit.setTextCursor({offset, length});
-    }
+    if(document->large) return findLarge(document, false);
+    findUpdate();
+    document->sourceEdit.searchPrevious();
   }
 }
 
+//large files are searched in full through their memory mapping, not just the window of lines in the SourceEdit
+auto Program::findLarge(shared_pointer<Document> document, bool forward) -> void {
+  auto& large = document->large;
+  auto search = findEdit.text();
+  auto data = (const char*)large->map.data();
+  uint64_t size = large->map.size();
+  uint length = search.size();
+  if(length > size) return;
+  uint64_t last = size - length + 1;  //matches must begin before last
+  uint64_t position = min(last, large->windowOffset(document->sourceEdit.textCursor().offset()));
+  bool caseSensitive = findCaseOption.checked();
+  bool wholeWord = findWordOption.checked();
+  auto word = [&](uint64_t offset) {
+    uint8_t c = data[offset];
+    return c == '_' || c >= 0x80 || c - '0' < 10u || (c | 0x20) - 'a' < 26u;
+  };
+  auto whole = [&](uint64_t offset) {
+    if(!wholeWord) return true;
+    return (offset == 0 || !word(offset - 1)) && (offset + length == size || !word(offset + length));
+  };
+  string_searcher searcher{search, !caseSensitive};
+  //first match in [from, to)
+  auto next = [&](uint64_t from, uint64_t to) -> maybe<uint64_t> {
+    while(auto offset = searcher.find(data, size, from)) {
+      if(offset() >= to) break;
+      if(whole(offset())) return offset();
+      from = offset() + 1;
+    }
+    return nothing;
+  };
+  //last match in [to, from)
+  auto previous = [&](uint64_t from, uint64_t to) -> maybe<uint64_t> {
+    while(auto offset = searcher.findPrevious(data, size, from)) {
+      if(offset() < to) break;
+      if(whole(offset())) return offset();
+      from = offset();
+    }
+    return nothing;
+  };
+  maybe<uint64_t> match;
+  uint64_t line = 0;
+  uint column = 0;
+  //if another program truncated the file, there is no match to go to
+  bool readable = file_map::guard([&] {
+    if(forward) {
+      match = next(min(last, position + 1), last);
+      if(!match) match = next(0, min(last, position + 1));
+    } else {
+      match = previous(position, 0);
+      if(!match) match = previous(last, position);
+    }
+    if(!match) return;
+    line = large->lineAt(match());
+    uint64_t lineStart = large->lineOffset(line);
+    column = characters(string_view{data + lineStart, uint(match() - lineStart)}) + 1;
+  });
+  if(!readable || !match) return;
+  documentGoto(document, line + 1, column, search.characters());
+}
+
 auto Program::gotoLine() -> void {
   if(!gotoEdit.text()) return;
-  if(auto document = documentActive()) {
-    auto line = max(1, gotoEdit.text().natural());
-    auto text = document->sourceEdit.text();
-    uint currentLine = 1;
-    for(uint offset : range(text.size())) {
-      if(line == currentLine) {
-        offset = text.characters(0, offset);
-        document->sourceEdit.setTextCursor(offset);
-        return;
-      }
-      if(text[offset] == '\n') currentLine++;
+  documentGoto(documentActive(), max(1, gotoEdit.text().natural()));
+}
+
+//line and column are 1-based; column and length are in UTF-8 characters
+auto Program::documentGoto(shared_pointer<Document> document, uint line, uint column, uint length) -> void {
+  if(!document || !document->loaded || document->type == "binary") return;
+  if(auto& large = document->large) {
+    uint64_t target = max(1u, line) - 1;
+    if(target < large->windowLine || target >= large->windowLine + large->windowLines) {
+      if(!documentWindow(document, target - min(target, (uint64_t)LargeFile::WindowLines / 2))) return;
     }
-    document->sourceEdit.setTextCursor(text.characters());
+    line = target - large->windowLine + 1;
   }
+  auto& sourceEdit = document->sourceEdit;
+  uint offset = sourceEdit.lineOffset(max(1u, line) - 1);
+  sourceEdit.setTextCursor({(int)(offset + max(1u, column) - 1), (int)length});
+  sourceEdit.setFocused();
 }
 
 SaveDialog::SaveDialog() {
   layout.setPadding(5);
-  promptLabel.setFont(getFont("window/font"));
-  tableView.setFont(getFont("save/font"));
-  tableView.setBackgroundColor(getColor("save/color/background"));
-  tableView.setForegroundColor(getColor("save/color/standard"));
-  selectAllButton.setText("Select All").setFont(getFont("window/font")).onActivate([&] {
+  settingsApply();
+  selectAllButton.setText("Select All").onActivate([&] {
     for(auto item : tableView.items()) item.cell(0).setChecked(true);
   });
-  deselectAllButton.setText("Deselect All").setFont(getFont("window/font")).onActivate([&] {
+  deselectAllButton.setText("Deselect All").onActivate([&] {
     for(auto item : tableView.items()) item.cell(0).setChecked(false);
   });
-  quitButton.setText("Don't Save").setFont(getFont("window/font")).onActivate([&] { close(true); });
-  saveQuitButton.setText("Save & Quit").setFont(getFont("window/font")).onActivate([&] { saveSelected(); close(true); });
-  cancelButton.setText("Cancel").setFont(getFont("window/font")).onActivate([&] { close(false); });
+  quitButton.setText("Don't Save").onActivate([&] { close(true); });
+  saveQuitButton.setText("Save & Quit").onActivate([&] { close(saveSelected()); });
+  cancelButton.setText("Cancel").onActivate([&] { close(false); });
   onClose([&] { close(false); });
   setTitle("amethyst");
   setDismissable();
   setSize({640, 400});
 }
 
+auto SaveDialog::settingsApply() -> void {
+  promptLabel.setFont(settings.window.font);
+  tableView.setFont(settings.save.font);
+  tableView.setBackgroundColor(settings.save.background);
+  tableView.setForegroundColor(settings.save.standard);
+  selectAllButton.setFont(settings.window.font);
+  deselectAllButton.setFont(settings.window.font);
+  quitButton.setFont(settings.window.font);
+  saveQuitButton.setFont(settings.window.font);
+  cancelButton.setFont(settings.window.font);
+}
+
 auto SaveDialog::run() -> bool {
   tableView.reset();
   tableView.append(TableViewColumn().setWidth(~0));
-  for(auto document : program.documents) {
+  for(auto document : program.loadedDocuments) {
     if(!document->modified) continue;
     TableViewItem item{&tableView};
-    item.setAttribute("document", document->treeViewItem.attribute("document"));
+    item.setAttribute<shared_pointer_weak<Document>>("document", shared_pointer_weak<Document>{document});
     TableViewCell cell{&item};
     cell.setText(document->title().trimLeft("*", 1L)).setCheckable().setChecked();
   }
@@ -672,13 +2134,19 @@ auto SaveDialog::run() -> bool {
   return quit;
 }
 
-auto SaveDialog::saveSelected() -> void {
+//returns false if any document could not be saved, so that quitting does not discard it
+auto SaveDialog::saveSelected() -> bool {
+  vector<shared_pointer<Document>> documents;
   for(auto item : tableView.items()) {
     if(!item.cell(0).checked()) continue;
-    if(auto document = program.documentFind(item)) {
-      program.documentSave(saveDialog, document);
-    }
+    if(auto document = program.documentFind(item)) documents.append(document);
+  }
+  program.documentSave(saveDialog, documents);
+  if(!program.saveWait()) return false;
+  for(auto& document : documents) {
+    if(document->modified) return false;  //declined, or edited while it was written
   }
+  return true;
 }
 
 auto SaveDialog::close(bool quit) -> void {
@@ -687,13 +2155,262 @@ auto SaveDialog::close(bool quit) -> void {
   setVisible(false);
 }
 
+QuickOpen::QuickOpen() {
+  layout.setPadding(5);
+  settingsApply();
+  queryEdit.onChange([&] { refresh(); });
+  queryEdit.onActivate([&] { accept(); });
+  resultsView.onActivate([&](auto) { accept(); });
+  setTitle("Open File");
+  setDismissable();
+  setSize({640, 400});
+}
+
+auto QuickOpen::settingsApply() -> void {
+  queryEdit.setFont(settings.open.font);
+  queryEdit.setBackgroundColor(settings.open.background);
+  queryEdit.setForegroundColor(settings.open.standard);
+  resultsView.setFont(settings.open.font);
+  resultsView.setBackgroundColor(settings.open.background);
+  resultsView.setForegroundColor(settings.open.standard);
+  statusLabel.setFont(settings.window.font);
+}
+
+auto QuickOpen::run() -> void {
+  queryEdit.setText("");
+  refresh();
+  setAlignment(program);
+  setVisible();
+  queryEdit.setFocused();
+}
+
+auto QuickOpen::refresh() -> void {
+  auto& index = program.index;
+  resultsView.reset();
+  resultsView.append(TableViewColumn().setWidth(~0));
+  vector<uint> matches;
+  if(auto query = queryEdit.text()) matches = index.search(query, 100);
+  for(auto match : matches) {
+    TableViewItem item{&resultsView};
+    item.setAttribute("location", index.location(match));
+    TableViewCell{&item}.setText(string{index.path(match)});
+  }
+  if(matches) resultsView.item(0).setSelected();
+  string status{index.size(), " files"};
+  if(index.building()) status.append(" (indexing ...)");
+  statusLabel.setText(status);
+}
+
+auto QuickOpen::accept() -> void {
+  auto item = resultsView.selected();
+  if(!item && resultsView.itemCount()) item = resultsView.item(0);
+  if(!item) return;
+  auto location = item.attribute("location");
+  setVisible(false);
+  program.documentReveal(location);
+}
+
+//runs on a worker thread: claims one path at a time from the job, until every path has been searched
+static auto searchWorker(uintptr parameter) -> void {
+  auto job = (SearchJob*)parameter;
+  string_searcher searcher{job->needle};
+  while(!job->cancelled) {
+    uint index = job->next++;
+    if(index >= job->offsets.size()) break;
+    string location{job->root.data(), job->paths.data() + job->offsets[index]};
+
+    //only search files that mimetypes.bml classifies as text
+    if(!job->mimeTypes.text(Location::base(location))) continue;
+
+    file_map map{location, file_map::mode::read};
+    if(!map) continue;
+    if(++job->searched % 256 == 0) workerWakeup.signal();  //the status shows how many files have been searched
+    auto data = (const char*)map.data();
+    auto end = data + map.size();
+    vector<SearchJob::Match> matches;
+    uint line = 1;
+    auto lineStart = data;
+    auto counted = data;  //newlines before this point have been counted
+    //skip the file if another program truncates it while it is searched
+    bool readable = file_map::guard([&] {
+      for(uint64_t offset = 0; auto found = searcher.find(data, map.size(), offset);) {
+        auto p = data + found();
+        if(job->found++ >= job->limit) { job->cancelled = true; break; }
+        while(auto newline = (const char*)memchr(counted, '\n', p - counted)) {
+          line++;
+          counted = lineStart = newline + 1;
+        }
+        counted = p;
+        auto lineEnd = (const char*)memchr(p, '\n', end - p);
+        if(!lineEnd) lineEnd = end;
+        auto preview = lineStart;
+        while(preview < lineEnd && (*preview == ' ' || *preview == '\t')) preview++;
+        uint size = min(lineEnd - preview, (ptrdiff_t)256);
+        while(preview + size < lineEnd && (preview[size] & 0xc0) == 0x80) size--;  //do not split a UTF-8 sequence
+        SearchJob::Match match;
+        match.location = (const char*)location;  //deep copy: location is released by this thread
+        match.line = line;
+        match.column = characters(string_view{lineStart, uint(p - lineStart)}) + 1;
+        match.preview = string{string_view{preview, size}}.trimRight("\r", 1L);
+        matches.append(move(match));
+        offset = lineEnd - data;  //list each line only once
+      }
+    });
+    if(!readable) continue;
+    if(matches) {
+      {
+        lock_guard<mutex> guard(job->lock);
+        job->received.append(move(matches));
+      }
+      workerWakeup.signal();
+    }
+  }
+  {
+    lock_guard<mutex> guard(job->lock);
+    job->running--;
+  }
+  workerWakeup.signal();
+}
+
+FindInFiles::FindInFiles() {
+  layout.setPadding(5);
+  settingsApply();
+  queryEdit.onActivate([&] { search(); });
+  searchButton.setBordered(false).setIcon(Icon::Action::Search).onActivate([&] { search(); });
+  cancelButton.setBordered(false).setIcon(Icon::Action::Stop).setEnabled(false).onActivate([&] { cancel(); });
+  resultsView.onActivate([&](auto) { accept(); });
+  onClose([&] { cancel(); setVisible(false); });
+  setTitle("Find in Files");
+  setDismissable();
+  setSize({800, 480});
+}
+
+auto FindInFiles::settingsApply() -> void {
+  queryEdit.setFont(settings.search.font);
+  queryEdit.setBackgroundColor(settings.search.background);
+  queryEdit.setForegroundColor(settings.search.standard);
+  resultsView.setFont(settings.search.font);
+  resultsView.setBackgroundColor(settings.search.background);
+  resultsView.setForegroundColor(settings.search.standard);
+  statusLabel.setFont(settings.window.font);
+}
+
+auto FindInFiles::run() -> void {
+  setAlignment(program);
+  setVisible();
+  queryEdit.setFocused();
+}
+
+//search every file in the file index on a pool of worker threads; matches are listed as they are found
+auto FindInFiles::search() -> void {
+  reset();
+  resultsView.reset();
+  resultsView.setHeadered();
+  resultsView.append(TableViewColumn().setText("Location"));
+  resultsView.append(TableViewColumn().setText("Line").setAlignment(1.0));
+  resultsView.append(TableViewColumn().setText("Preview").setExpandable());
+  auto needle = queryEdit.text();
+  if(!needle) return setStatus();
+  auto& index = program.index;
+  if(index.building()) {
+    deferred = true;  //Program::workerPoll() will start the search once the file list is complete
+    return (void)statusLabel.setText("Waiting for the file index ...");
+  }
+
+  job = new SearchJob;
+  job->root = (const char*)index.root;
+  job->needle = (const char*)needle;
+  job->paths = index.snapshot();
+  for(uint offset = 0, start = 0; offset < job->paths.size(); offset++) {
+    if(job->paths.data()[offset]) continue;
+    job->offsets.append(start);
+    start = offset + 1;
+  }
+  job->mimeTypes.load(mimetypes);
+  job->limit = 10000;
+  uint count = max(1u, min(thread::concurrency(), (uint)job->offsets.size()));
+  job->running = count;
+  for(uint n : range(count)) job->workers.append(thread::create(searchWorker, (uintptr)job.data()));
+  program.workerStart();
+  cancelButton.setEnabled();
+  setStatus();
+}
+
+//drain matches received from the worker threads, a bounded number per wakeup to keep the GUI responsive
+auto FindInFiles::poll() -> void {
+  if(!job || !job->workers) return;
+  bool finished = false;
+  {
+    lock_guard<mutex> guard(job->lock);
+    pending.append(move(job->received));
+    job->received.reset();
+    finished = job->running == 0;
+  }
+  uint count = min(512u, (uint)pending.size());
+  for(uint offset : range(count)) {
+    auto& match = pending[offset];
+    TableViewItem item{&resultsView};
+    item.setAttribute("location", match.location);
+    item.setAttribute<uint>("line", match.line);
+    item.setAttribute<uint>("column", match.column);
+    TableViewCell{&item}.setText(string{match.location}.trimLeft(job->root, 1L));
+    TableViewCell{&item}.setText(match.line);
+    TableViewCell{&item}.setText(match.preview);
+  }
+  pending.removeLeft(count);
+  results += count;
+  if(finished && !pending) {
+    for(auto& worker : job->workers) worker.join();
+    job->workers.reset();
+    cancelButton.setEnabled(false);
+  }
+  if(pending) workerWakeup.signal();  //continue with the matches left over
+  setStatus();
+}
+
+//stop the worker threads; matches already found are still listed
+auto FindInFiles::cancel() -> void {
+  if(job) job->cancelled = true;
+}
+
+//wait for the worker threads to exit, and discard the previous search
+auto FindInFiles::reset() -> void {
+  if(job) {
+    job->cancelled = true;
+    for(auto& worker : job->workers) worker.join();
+    job.reset();
+  }
+  pending.reset();
+  results = 0;
+  deferred = false;
+  cancelButton.setEnabled(false);
+}
+
+auto FindInFiles::accept() -> void {
+  auto item = resultsView.selected();
+  if(!item || !job) return;
+  program.documentReveal(item.attribute("location"), item.attribute<uint>("line"), item.attribute<uint>("column"), job->needle.characters());
+}
+
+auto FindInFiles::setStatus() -> void {
+  if(!job) return (void)statusLabel.setText("");
+  string status{results, results == 1 ? " match in " : " matches in ", job->searched.load(), " files"};
+  if(job->workers) status.append(" (searching ...)");
+  else if(job->found > job->limit) status.append(" (stopped after ", job->limit, " matches)");
+  else if(job->cancelled) status.append(" (cancelled)");
+  statusLabel.setText(status);
+}
+
 #include <nall/main.hpp>
+#if !defined(AMETHYST_BENCHMARK)  //benchmark/benchmark.cpp provides its own entry point
 auto nall::main(Arguments arguments) -> void {
-  settings = BML::unserialize(file::read(locate("settings.bml")));
+  settings.load(BML::unserialize(file::read(locate("settings.bml"))));
   Application::setName("amethyst");
 
   Instances::program.construct();
   Instances::saveDialog.construct();
+  Instances::quickOpen.construct();
+  Instances::findInFiles.construct();
 
   if(!file::exists(locate("settings.bml")) || !file::exists(locate("mimetypes.bml"))) {
     return (void)MessageDialog().setTitle("amethyst").setText({
@@ -704,10 +2421,14 @@ auto nall::main(Arguments arguments) -> void {
 
   //todo: somehow, settings is reset between hiro::initialize() and nall::main()
   //this is a *serious* problem, but for now, reload settings to work around it
-  settings = BML::unserialize(file::read(locate("settings.bml")));
+  settings.load(BML::unserialize(file::read(locate("settings.bml"))));
   mimetypes = BML::unserialize(file::read(locate("mimetypes.bml")));
+  mimeTypes.load(mimetypes);
   program.main(arguments);
 
   Instances::program.destruct();
   Instances::saveDialog.destruct();
+  Instances::quickOpen.destruct();
+  Instances::findInFiles.destruct();
 }
+#endif
@@ -1,20 +1,233 @@
+//text files too large to load at once are memory-mapped, and only a window of their lines is placed in the SourceEdit
+//the line index keeps the offset of every Stride'th line, and is built on a worker thread
+struct LargeFile {
+  static constexpr uint64_t Threshold = 16 * 1024 * 1024;  //files at least this large are opened as large files
+  static constexpr uint Stride = 1024;
+  static constexpr uint WindowLines = 4096;               //lines placed in the SourceEdit at once
+  static constexpr uint WindowSize = 4 * 1024 * 1024;     //limit on the bytes placed in the SourceEdit at once
+
+  ~LargeFile();
+  auto open(const string& location) -> bool;
+  auto indexed() -> bool;
+  auto lineCount() -> uint64_t;
+  auto lineOffset(uint64_t line) -> uint64_t;
+  auto lineAt(uint64_t offset) -> uint64_t;
+  auto setWindow(uint64_t line) -> string;
+  auto windowOffset(uint characters) const -> uint64_t;
+
+  file_map map;
+  uint64_t windowLine = 0;    //first line in the SourceEdit (0-based)
+  uint64_t windowLines = 0;   //number of lines in the SourceEdit
+  uint64_t windowStart = 0;   //byte range of the file in the SourceEdit
+  uint64_t windowEnd = 0;
+  UTF8::Offsets windowOffsets;  //converts SourceEdit character offsets into byte offsets within the window
+
+  thread worker;
+  bool active = false;
+  atomic<bool> cancelled = false;
+  mutex lock;                 //guards the fields below, which are shared with the worker thread
+  vector<uint64_t> checkpoints;
+  uint64_t lines = 1;         //lines found so far
+  bool finished = false;
+};
+
+//settings.bml resolved into typed values once, instead of being queried by path whenever a widget is styled
+struct Settings {
+  struct Pane {
+    Font font;
+    Color background;
+    Color standard;
+  };
+
+  auto load(const Markup::Node& document) -> void;
+
+  struct {
+    float x = 0, y = 0, width = 0, height = 0;
+    Font font;
+  } window;
+  struct {
+    Font font;
+  } menu;
+  struct : Pane {
+    float width = 0;
+    Color modified;
+    Color desynced;
+    Color readonly;
+  } browser;
+  struct : Pane {
+    string scheme;
+    float budget = 0;  //in MiB
+  } editor;
+  Pane find;
+  Pane jump;  //goto
+  Pane save;
+  Pane open;
+  Pane search;
+};
+
+//mimetypes.bml compiled for classifying file names: exact names and "*.extension" patterns are found in hash tables,
+//and only the remaining patterns are glob-matched; as with the file itself, the earliest matching rule wins
+struct MimeTypes {
+  auto load(const Markup::Node& document) -> void;
+  auto language(string_view name) -> string;  //empty for binary files
+  auto text(string_view name) -> bool { return (bool)rules.find(name); }
+
+private:
+  glob_set rules;        //each file match pattern, in the order listed
+  vector<string> types;  //the type of each rule
+};
+
 //Document may not be the most descriptive name, since folders are included ...
+//documents form a tree mirroring the TreeView: each stores only its name within its parent folder,
+//so that renaming a folder relinks one node, and its descendants rebuild their locations when next used
 struct Document {
+  auto location() const -> const string&;
+  auto relink(string segment) -> void;
   auto language() const -> string;
   auto name() const -> string;
   auto title() const -> string;
   auto update() -> void;
   auto rename(string) -> void;
 
-  string location;         //file system path
+  Document* parent = nullptr;  //folder containing this document, or nullptr when it is listed directly in the TreeView
+  string segment;          //name within parent ("name/" for folders), or the full path when there is no parent
+  nall::map<string, shared_pointer<Document>> children;  //listed contents of a folder, by segment
   string type;             //"folder", "binary", "text"
   bool loaded = false;     //used to delay loading contents
   uint64_t timestamp = 0;  //used to detect when a file was modified externally after loading
+  uint64_t size = 0;       //compared as well, since timestamps only have a resolution of one second
   bool writable = false;   //indicates whether location is writable (true) or read-only (false)
   bool modified = false;   //only "text" files will set modified = true
   bool desynced = false;   //set to true when file has been modified externally
-  SourceEdit sourceEdit;
+  bool saving = false;     //set while a worker thread writes the document
+  bool saveQueued = false; //saved again once the current save completes
+  uint revision = 0;       //incremented by every edit: a save only clears modified if none were made while it was written
+  SourceEdit sourceEdit;   //"text" documents
+  HexEdit hexEdit;         //"binary" documents
   TreeViewItem treeViewItem;
+  shared_pointer<LargeFile> large;  //set when a "text" document was too large to be loaded at once
+  file_map map;            //"binary" documents are read through a memory mapping
+
+  uint64_t resident = 0;   //estimated bytes held while loaded, counted against editor/budget
+  uint64_t used = 0;       //when the document was last shown: the least recently used are unloaded first
+  TextCursor cursor;       //positions restored when an unloaded document is shown again
+  uint64_t address = 0;
+  uint64_t windowLine = 0;
+
+private:
+  static uint64_t relinks;         //incremented by every relink(), which invalidates all cached locations
+  mutable string cachedLocation;
+  mutable uint64_t cachedRelinks = 0;
+};
+
+//folders are listed on a worker thread, and their contents are streamed back to the GUI thread in chunks
+struct ScanJob {
+  struct Entry {
+    string name;
+    bool writable = false;
+  };
+
+  string location;                         //private copy for the worker thread (nall::string is not thread-safe)
+  shared_pointer_weak<Document> parent;    //null when scanning rootLocation into the TreeView itself
+  TreeViewItem placeholder;                //"scanning ..." item kept at the end of the folder until the scan completes
+  set<string> existing;                    //names already present in the folder, when resuming a cancelled scan
+  bool validate = false;                   //folder was restored from the session: remove the names that no longer exist
+  set<string> seen;                        //names received, when validating
+  vector<Entry> pending;                   //received entries not yet appended to the TreeView
+  thread worker;
+  atomic<bool> cancelled = false;
+
+  vector<function<void ()>> onFinish;      //invoked once every entry has been appended (not when cancelled)
+
+  mutex lock;                              //guards the fields below, which are shared with the worker thread
+  vector<Entry> received;
+  bool finished = false;
+};
+
+//project-wide list of files beneath rootLocation, cached on disk so that a restart does not walk the tree again
+struct FileIndex {
+  auto cache() const -> string;
+  auto load(string root) -> bool;
+  auto save() -> void;
+  auto build(string root) -> void;
+  auto poll() -> bool;
+  auto building() const -> bool { return active; }
+  auto insert(string location) -> void;
+  auto remove(string location) -> void;
+  auto rename(string oldLocation, string newLocation) -> void;
+  auto search(string query, uint limit) -> vector<uint>;
+  auto snapshot() const -> string;
+  auto path(uint index) const -> string_view { return {text.data() + offsets[index], offsets[index + 1] - offsets[index] - 1}; }
+  auto location(uint index) const -> string { return {root, path(index)}; }
+  auto size() const -> uint { return offsets ? offsets.size() - 1 : 0; }
+
+  string root;
+  bool modified = false;     //contents differ from the on-disk cache
+
+private:
+  auto lowerBound(string_view path) const -> uint;
+  auto upperBound(string_view path, uint lower) const -> uint;
+  auto splice(uint lower, uint upper, string_view packed = {}) -> void;
+  auto reindex() -> void;
+
+  string text;               //paths relative to root, sorted and packed into one buffer, each followed by a null byte
+  vector<uint> offsets;      //start of each path in text, plus the end of the last path
+  vector<uint64_t> masks;    //set of characters in each path, used to reject fuzzy matches without scanning them
+
+  string lastQuery;          //searches that extend lastQuery only need to rescan lastMatches
+  vector<uint> lastMatches;
+
+  string pathname;           //private copy of root for the worker thread
+  thread worker;
+  bool active = false;
+  mutex lock;                //guards the fields below, which are shared with the worker thread
+  string built;
+  bool finished = false;
+};
+
+//Find in Files: text files beneath rootLocation are memory-mapped and searched by a pool of worker threads
+struct SearchJob {
+  struct Match {
+    string location;
+    uint line = 0;    //1-based
+    uint column = 0;  //1-based, in UTF-8 characters
+    string preview;   //contents of the matching line
+  };
+
+  string root;                   //private copies for the worker threads (nall::string is not thread-safe)
+  string needle;
+  string paths;                  //FileIndex::snapshot(): relative paths, each followed by a null byte
+  vector<uint> offsets;          //start of each path in paths
+  MimeTypes mimeTypes;           //files that mimetypes.bml does not classify as text are binary, and are skipped
+  uint limit = 0;                //stop searching once this many matches are found
+  vector<thread> workers;
+  atomic<uint> next = 0;         //index of the next path to be claimed by a worker
+  atomic<uint> found = 0;
+  atomic<uint> searched = 0;
+  atomic<bool> cancelled = false;
+
+  mutex lock;                    //guards the fields below, which are shared with the worker threads
+  vector<Match> received;
+  uint running = 0;              //workers that have not exited yet
+};
+
+//documents are written on a pool of worker threads, each through a temporary file that replaces the original once complete
+struct SaveJob {
+  struct Entry {
+    shared_pointer_weak<Document> document;  //only touched on the GUI thread
+    uint revision = 0;
+    string location;                         //private copies for the worker threads (nall::string is not thread-safe)
+    string text;
+    bool saved = false;                      //written by the worker that claimed the entry
+  };
+
+  vector<Entry> entries;
+  vector<thread> workers;
+  atomic<uint> next = 0;   //index of the next entry to be claimed by a worker
+
+  mutex lock;              //guards the fields below, which are shared with the worker threads
+  vector<uint> finished;   //entries written (or failed) since the last poll
+  uint running = 0;        //workers that have not exited yet
 };
 
 struct Program : Window {
@@ -22,36 +235,89 @@ struct Program : Window {
   auto main(Arguments) -> void;
   auto close() -> void;
   auto setTitle() -> void;
-  auto scan(string pathname) -> void;
-  template<typename T> auto scan(T parent, string pathname) -> void;
-  template<typename T> auto append(T parent, string location = "") -> TreeViewItem;
+  auto scan(shared_pointer<Document> parent, string location, bool validate = false) -> void;
+  auto scanPoll() -> void;
+  auto scanCancel(shared_pointer<Document> parent) -> bool;
+  auto scanReset() -> void;
+  auto scanActive(shared_pointer<Document> parent) -> shared_pointer<ScanJob>;
+  template<typename T> auto scanSort(T parent) -> void;
+  template<typename T> auto append(T parent, string location = "", maybe<bool> writable = nothing) -> TreeViewItem;
+  auto workerPoll() -> void;
+  auto workerStart() -> void;
+  auto workerBusy() -> bool;
+  auto watchPoll() -> void;
+
+  auto sessionLocation() const -> string;
+  auto sessionLoad() -> bool;
+  auto sessionSave() -> void;
+  auto sessionPoll() -> void;
+
+  auto settingsPoll() -> void;
+  auto settingsApply() -> void;
 
   template<typename T> auto documentFind(T item) -> shared_pointer<Document>;
+  auto documentLocate(const string& location) -> shared_pointer<Document>;
   auto documentActive() -> shared_pointer<Document>;
   auto documentActivate() -> void;
   auto documentChange() -> void;
+  auto documentLoad(shared_pointer<Document>) -> bool;
+  auto documentUnload(shared_pointer<Document>) -> void;
+  auto documentEvict() -> void;
+  auto documentUsage() -> void;
+  auto documentReveal(string location, uint line = 0, uint column = 0, uint length = 0) -> void;
+  auto documentGoto(shared_pointer<Document>, uint line, uint column = 1, uint length = 0) -> void;
+  auto documentSync(shared_pointer<Document>) -> void;
+  auto documentRemove(shared_pointer<Document>) -> void;
+  auto documentDetach(shared_pointer<Document>) -> void;
   auto documentModify() -> void;
-  auto documentSave(Window parent, shared_pointer<Document>) -> void;
-  auto documentBinary(string location) -> string;
+  auto documentSave(Window parent, vector<shared_pointer<Document>>) -> void;
+  auto savePoll() -> bool;
+  auto saveWait() -> bool;
+  auto documentBinary(shared_pointer<Document>) -> void;
+  auto documentWindow(shared_pointer<Document>, uint64_t line) -> bool;
+  auto documentWindowUpdate() -> void;
 
+  auto findUpdate() -> void;
+  auto findChange() -> void;
+  auto findCount() -> void;
   auto findNext() -> void;
   auto findPrevious() -> void;
+  auto findLarge(shared_pointer<Document>, bool forward) -> void;
 
   auto gotoLine() -> void;
 
   string rootLocation;
-  vector<shared_pointer<Document>> documents;
+  map<string, shared_pointer<Document>> documents;   //documents listed directly in the TreeView, by location
+  vector<shared_pointer<Document>> loadedDocuments;  //documents whose editor exists: only these can be modified
+  shared_pointer<Document> shownDocument;            //document whose editor is visible
+  uint64_t documentsShown = 0;  //incremented each time a document is shown, to order Document::used
+  vector<shared_pointer<ScanJob>> scanJobs;
+  vector<shared_pointer<SaveJob>> saveJobs;
+  set<string> savePartials;  //temporary files being written, which the file watcher should not list
+  vector<shared_pointer_weak<Document>> sessionFolders;    //restored (or rescanned) folders not yet validated against the file system
+  vector<shared_pointer_weak<Document>> sessionDocuments;  //documents that were loaded at exit, reloaded in the background
+  FileIndex index;
+  file_watcher watcher;      //folders listed in the TreeView, so that it follows changes made by other programs
+  bool workerWatched = false;  //the event loop waits on workerWakeup, rather than workerPollTimer polling it
+  string settingsLocation;        //settings.bml, whose folder is watched
+  uint64_t settingsModified = 0;  //timestamp of settings.bml when it was last loaded
+  uint64_t settingsSize = 0;      //and its size
 
   MenuBar menuBar{this};
     Menu fileMenu{&menuBar};
+      MenuItem openAction{&fileMenu};
+      MenuItem reindexAction{&fileMenu};
+      MenuSeparator saveSeparator{&fileMenu};
       MenuItem saveAction{&fileMenu};
       MenuItem saveAllAction{&fileMenu};
       MenuSeparator quitSeparator{&fileMenu};
       MenuItem quitAction{&fileMenu};
     Menu searchMenu{&menuBar};
       MenuItem findAction{&searchMenu};
+      MenuItem findFilesAction{&searchMenu};
       MenuItem gotoAction{&searchMenu};
     Menu helpMenu{&menuBar};
+      MenuItem usageAction{&helpMenu};
       MenuItem aboutAction{&helpMenu};
 
   HorizontalLayout layout{this};
@@ -60,9 +326,16 @@ struct Program : Window {
     VerticalLayout editorLayout{&layout, Size{~0, ~0}};
       HorizontalLayout documentLayout{&editorLayout, Size{~0, ~0}, 3};
         TextEdit noDocument{&documentLayout, Size{~0, ~0}};
+      HorizontalLayout windowLayout{&editorLayout, Size{~0, 0}, 3};
+        Label windowLabel{&windowLayout, Size{~0, 0}};
+        Button windowPreviousButton{&windowLayout, Size{0, 0}, 0};
+        Button windowNextButton{&windowLayout, Size{0, 0}, 0};
       HorizontalLayout findLayout{&editorLayout, Size{~0, 0}, 3};
         Label findLabel{&findLayout, Size{0, 0}};
         LineEdit findEdit{&findLayout, Size{~0, 0}};
+        Label findCountLabel{&findLayout, Size{0, 0}};
+        CheckLabel findCaseOption{&findLayout, Size{0, 0}};
+        CheckLabel findWordOption{&findLayout, Size{0, 0}};
         Button findNextButton{&findLayout, Size{0, 0}, 0};
         Button findPreviousButton{&findLayout, Size{0, 0}, 0};
         Button findCloseButton{&findLayout, Size{0, 0}, 0};
@@ -79,13 +352,16 @@ struct Program : Window {
     MenuItem removeDocumentAction{&treeViewFolderMenu};
 
   Timer keyboardPollTimer;
+  Timer workerPollTimer;
+  Timer watchPollTimer;
   float resizeWidth = 0;
 };
 
 struct SaveDialog : Window {
   SaveDialog();
+  auto settingsApply() -> void;
   auto run() -> bool;
-  auto saveSelected() -> void;
+  auto saveSelected() -> bool;
   auto close(bool quit) -> void;
 
   bool quit = true;
@@ -101,3 +377,41 @@ struct SaveDialog : Window {
       Button saveQuitButton{&controlLayout, Size{100, 0}};
       Button cancelButton{&controlLayout, Size{100, 0}};
 };
+
+struct QuickOpen : Window {
+  QuickOpen();
+  auto settingsApply() -> void;
+  auto run() -> void;
+  auto refresh() -> void;
+  auto accept() -> void;
+
+  VerticalLayout layout{this};
+    LineEdit queryEdit{&layout, Size{~0, 0}};
+    TableView resultsView{&layout, Size{~0, ~0}};
+    Label statusLabel{&layout, Size{~0, 0}};
+};
+
+struct FindInFiles : Window {
+  FindInFiles();
+  auto settingsApply() -> void;
+  auto run() -> void;
+  auto search() -> void;
+  auto poll() -> void;
+  auto cancel() -> void;
+  auto reset() -> void;
+  auto accept() -> void;
+  auto setStatus() -> void;
+
+  shared_pointer<SearchJob> job;
+  bool deferred = false;             //search() was called while the file index was being built
+  vector<SearchJob::Match> pending;  //received matches not yet appended to resultsView
+  uint results = 0;
+
+  VerticalLayout layout{this};
+    HorizontalLayout controlLayout{&layout, Size{~0, 0}, 3};
+      LineEdit queryEdit{&controlLayout, Size{~0, 0}};
+      Button searchButton{&controlLayout, Size{0, 0}, 0};
+      Button cancelButton{&controlLayout, Size{0, 0}, 0};
+    TableView resultsView{&layout, Size{~0, ~0}};
+    Label statusLabel{&layout, Size{~0, 0}};
+};
@@ -0,0 +1,244 @@
+//times the editor's core operations against synthetic files, and prints the results as BML
+//each case reports its wall time, the peak resident set size reached while it ran, and the number of allocations
+//GTK still requires a display: 'make benchmark' runs this under xvfb-run when none is set
+
+#define AMETHYST_BENCHMARK
+#include "../amethyst.cpp"
+
+#include <cinttypes>
+
+#if defined(PLATFORM_LINUX)
+  #include <unistd.h>
+#endif
+
+namespace Benchmark {
+  atomic<uint64_t> allocations = 0;
+}
+
+//glibc allows malloc to be replaced by definition: every allocation made by nall, hiro and GTK passes through here
+#if defined(__GLIBC__)
+extern "C" {
+  auto __libc_malloc(size_t size) -> void*;
+  auto __libc_calloc(size_t count, size_t size) -> void*;
+  auto __libc_realloc(void* data, size_t size) -> void*;
+
+  auto malloc(size_t size) noexcept -> void* {
+    Benchmark::allocations++;
+    return __libc_malloc(size);
+  }
+
+  auto calloc(size_t count, size_t size) noexcept -> void* {
+    Benchmark::allocations++;
+    return __libc_calloc(count, size);
+  }
+
+  auto realloc(void* data, size_t size) noexcept -> void* {
+    Benchmark::allocations++;
+    return __libc_realloc(data, size);
+  }
+}
+#endif
+
+namespace Benchmark {
+
+struct Case {
+  string name;
+  uint64_t nanoseconds = 0;
+  uint64_t peak = 0;  //in KiB
+  uint64_t allocations = 0;
+};
+
+vector<Case> cases;
+
+//the peak resident set size can only be reset on Linux; elsewhere it is reported as 0
+auto peakReset() -> void {
+  #if defined(PLATFORM_LINUX)
+  if(auto fp = fopen("/proc/self/clear_refs", "wb")) fputs("5", fp), fclose(fp);
+  #endif
+}
+
+auto peak() -> uint64_t {
+  uint64_t kilobytes = 0;
+  #if defined(PLATFORM_LINUX)
+  //files in /proc report a size of 0, so they cannot be read through nall::file
+  if(auto fp = fopen("/proc/self/status", "rb")) {
+    char line[256];
+    while(fgets(line, sizeof(line), fp)) {
+      if(sscanf(line, "VmHWM: %" SCNu64, &kilobytes) == 1) break;
+    }
+    fclose(fp);
+  }
+  #endif
+  return kilobytes;
+}
+
+auto measure(string name, const function<void ()>& operation) -> void {
+  peakReset();
+  uint64_t allocated = allocations;
+  auto start = chrono::nanosecond();
+  operation();
+  auto end = chrono::nanosecond();
+  cases.append({name, end - start, peak(), allocations - allocated});
+}
+
+//process events until done() holds, as the event loop would while the user waits
+auto wait(const function<bool ()>& done) -> void {
+  while(!done()) {
+    Application::processEvents();
+    #if defined(PLATFORM_LINUX)
+    usleep(1000);
+    #endif
+  }
+}
+
+//deterministic, so that every run measures the same content
+auto random() -> uint64_t {
+  static uint64_t state = 0x9e3779b97f4a7c15;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+auto generateText(string location, uint64_t size) -> void {
+  file_buffer fp{location, file::mode::write};
+  for(uint64_t line = 1; fp.size() < size; line++) {
+    fp.writes({"line ", line, ": the quick brown fox jumps over the lazy dog ", hex(random()), "\n"});
+  }
+}
+
+auto generateBinary(string location, uint64_t size) -> void {
+  file_buffer fp{location, file::mode::write};
+  for(uint64_t offset = 0; offset < size; offset += 8) fp.writel(random(), 8);
+}
+
+//files are spread over folders of 256, so that every folder scan lists a realistic number of entries
+//the tree is kept between runs: it only depends on the parameters, and writing it is not what is measured
+auto generate(string root, uint files, uint megabytes) -> void {
+  if(file::exists({root, "complete"})) return;
+  directory::remove(root);
+  directory::create({root, "tree/"});
+  for(uint folder = 0; folder * 256 < files; folder++) {
+    string location{root, "tree/", pad(folder, 5, '0'), "/"};
+    directory::create(location);
+    for(uint n = folder * 256; n < min(files, folder * 256 + 256); n++) {
+      file::write({location, "file-", pad(n, 7, '0'), ".cpp"}, string{"//", n, "\n"});
+    }
+  }
+  generateText({root, "text.cpp"}, 8 * 1024 * 1024);  //below LargeFile::Threshold: loaded in full
+  generateText({root, "large.cpp"}, megabytes * 1024 * 1024);
+  generateBinary({root, "binary.bin"}, megabytes * 1024 * 1024);
+  file::write({root, "complete"}, string{});
+}
+
+auto show(string location) -> shared_pointer<Document> {
+  auto document = program.documentLocate(location);
+  document->treeViewItem.setSelected();
+  program.documentChange();
+  return document;
+}
+
+auto run(string root) -> void {
+  program.rootLocation = root;
+  program.setVisible();
+  Application::processEvents();
+
+  //lists the root, then every folder beneath it, as expanding each folder in turn would
+  measure("scan", [&] {
+    program.scan({}, root);
+    wait([&] { return program.scanPoll(), !program.scanJobs; });
+    auto tree = program.documentLocate({root, "tree/"});
+    tree->loaded = true;
+    program.scan(tree, tree->location());
+    wait([&] { return program.scanPoll(), !program.scanJobs; });
+    for(auto& node : tree->children) {
+      node.value->loaded = true;
+      program.scan(node.value, node.value->location());
+    }
+    wait([&] { return program.scanPoll(), !program.scanJobs; });
+  });
+
+  shared_pointer<Document> text, large;
+  measure("documentChange", [&] { text = show({root, "text.cpp"}); });
+  measure("documentChange.large", [&] {
+    large = show({root, "large.cpp"});
+    wait([&] { return large->large->indexed(); });
+  });
+  measure("documentBinary", [&] { show({root, "binary.bin"}); });
+
+  program.findAction.doActivate();
+  program.findEdit.setText("jumps over the lazy dog 1");
+  show({root, "text.cpp"});
+  measure("findNext", [&] {
+    for(uint n : range(100)) program.findNext();
+  });
+  show({root, "large.cpp"});
+  measure("findNext.large", [&] {
+    for(uint n : range(100)) program.findNext();
+  });
+  program.findCloseButton.doActivate();
+
+  program.gotoAction.doActivate();
+  show({root, "text.cpp"});
+  measure("gotoLine", [&] {
+    uint lines = text->sourceEdit.lineCount();
+    for(uint n : range(100)) program.gotoEdit.setText(string{random() % lines + 1}), program.gotoLine();
+  });
+  show({root, "large.cpp"});
+  measure("gotoLine.large", [&] {
+    uint64_t lines = large->large->lineCount();
+    for(uint n : range(100)) program.gotoEdit.setText(string{random() % lines + 1}), program.gotoLine();
+  });
+  program.gotoCloseButton.doActivate();
+
+  show({root, "text.cpp"});
+  auto original = file::read({root, "text.cpp"});
+  text->sourceEdit.setText({"//modified\n", text->sourceEdit.text()});
+  program.documentModify();
+  measure("documentSave", [&] {
+    program.documentSave(program, {text});
+    program.saveWait();
+  });
+  file::write({root, "text.cpp"}, original);  //the generated files are reused by later runs: keep them unchanged
+
+  program.scanReset();
+}
+
+}
+
+auto nall::main(Arguments arguments) -> void {
+  string files = "10000", megabytes = "64", revision;
+  arguments.take("--files", files);
+  arguments.take("--megabytes", megabytes);
+  arguments.take("--revision", revision);
+
+  string root{Path::temporary(), "amethyst-benchmark-", files, "-", megabytes, "/"};
+  Benchmark::generate(root, files.natural(), megabytes.natural());
+
+  settings.load(BML::unserialize(file::read(locate("settings.bml"))));
+  mimetypes = BML::unserialize(file::read(locate("mimetypes.bml")));
+  mimeTypes.load(mimetypes);
+  Application::setName("amethyst");
+  Instances::program.construct();
+  Instances::saveDialog.construct();
+  Instances::quickOpen.construct();
+  Instances::findInFiles.construct();
+
+  Benchmark::run(root);
+
+  print("benchmark\n");
+  if(revision) print("  revision: ", revision, "\n");
+  print("  files: ", files, "\n");
+  print("  megabytes: ", megabytes, "\n");
+  for(auto& entry : Benchmark::cases) {
+    print("  case: ", entry.name, "\n");
+    print("    nanoseconds: ", entry.nanoseconds, "\n");
+    print("    peak: ", entry.peak, "\n");
+    print("    allocations: ", entry.allocations, "\n");
+  }
+
+  Instances::program.destruct();
+  Instances::saveDialog.destruct();
+  Instances::quickOpen.destruct();
+  Instances::findInFiles.destruct();
+}
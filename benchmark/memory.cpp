@@ -0,0 +1,146 @@
+//compares nall::memory against the byte-at-a-time loops it replaced, and prints the results as BML
+//each result is checked against the loops first, so that a faster but wrong implementation cannot go unnoticed
+
+#include <nall/nall.hpp>
+#include <nall/main.hpp>
+using namespace nall;
+
+namespace Loop {
+
+auto compare(const void* target, uint capacity, const void* source, uint size) -> int {
+  auto t = (uint8_t*)target;
+  auto s = (uint8_t*)source;
+  auto l = min(capacity, size);
+  while(l--) {
+    auto x = *t++;
+    auto y = *s++;
+    if(x != y) return x - y;
+  }
+  if(capacity == size) return 0;
+  return -(capacity < size);
+}
+
+auto icompare(const void* target, uint capacity, const void* source, uint size) -> int {
+  auto t = (uint8_t*)target;
+  auto s = (uint8_t*)source;
+  auto l = min(capacity, size);
+  while(l--) {
+    auto x = *t++;
+    auto y = *s++;
+    if(x - 'A' < 26u) x += 32;
+    if(y - 'A' < 26u) y += 32;
+    if(x != y) return x - y;
+  }
+  return -(capacity < size);
+}
+
+auto copy(void* target, const void* source, uint size) -> void {
+  auto t = (uint8_t*)target;
+  auto s = (uint8_t*)source;
+  while(size--) *t++ = *s++;
+}
+
+auto move(void* target, const void* source, uint size) -> void {
+  auto t = (uint8_t*)target;
+  auto s = (uint8_t*)source;
+  if(t < s) {
+    while(size--) *t++ = *s++;
+  } else {
+    t += size;
+    s += size;
+    while(size--) *--t = *--s;
+  }
+}
+
+auto fill(void* target, uint size, uint8_t value) -> void {
+  auto t = (uint8_t*)target;
+  while(size--) *t++ = value;
+}
+
+}
+
+namespace Benchmark {
+
+//prevents the compiler from removing work whose result is unused
+volatile int sink = 0;
+
+auto random() -> uint64_t {
+  static uint64_t state = 0x9e3779b97f4a7c15;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return state;
+}
+
+auto verify() -> bool {
+  vector<uint8_t> x, y, a, b;
+  for(uint trial : range(100000)) {
+    uint size = random() % 300;
+    x.resize(size + 1), y.resize(size + 1);
+    //few distinct letters in either case, so that case-insensitive matches and late mismatches are common
+    for(uint n : range(size + 1)) x[n] = "aAbB\x80z"[random() % 6];
+    y = x;
+    if(size && random() % 2) y[random() % size] = "aAbB\x80zZ"[random() % 7];
+    uint capacity = size - (size ? random() % min(size, 4u) : 0);
+    if(memory::compare(x.data(), capacity, y.data(), size) != Loop::compare(x.data(), capacity, y.data(), size)) return false;
+    if(memory::icompare(x.data(), capacity, y.data(), size) != Loop::icompare(x.data(), capacity, y.data(), size)) return false;
+
+    a = x, b = x;
+    uint from = random() % (size + 1), to = random() % (size + 1), length = random() % (size + 1 - max(from, to));
+    memory::move(a.data() + to, a.data() + from, length);
+    Loop::move(b.data() + to, b.data() + from, length);
+    if(a != b) return false;
+    memory::copy(a.data(), y.data(), size);
+    Loop::copy(b.data(), y.data(), size);
+    memory::fill<uint8_t>(a.data(), from, trial);
+    Loop::fill(b.data(), from, trial);
+    if(a != b) return false;
+  }
+  return true;
+}
+
+auto measure(string name, uint size, const function<void ()>& current, const function<void ()>& loop) -> void {
+  uint64_t repeats = max(1u, 64 * 1024 * 1024 / max(1u, size));
+  auto time = [&](const function<void ()>& operation) {
+    auto start = chrono::nanosecond();
+    for(uint64_t n = 0; n < repeats; n++) operation();
+    return (chrono::nanosecond() - start) / (double)repeats;
+  };
+  double nanoseconds = time(current);
+  double reference = time(loop);
+  print("  case: ", name, "\n");
+  print("    size: ", size, "\n");
+  print("    nanoseconds: ", nanoseconds, "\n");
+  print("    loop: ", reference, "\n");
+}
+
+}
+
+auto nall::main(Arguments arguments) -> void {
+  using namespace Benchmark;
+  if(!verify()) return (void)print("error: nall::memory results differ from the loops\n");
+
+  print("memory\n");
+  for(uint size : {8, 32, 256, 4096, 65536, 1048576}) {
+    vector<uint8_t> x, y;
+    x.resize(size + 64), y.resize(size + 64);
+    for(uint n : range(size + 64)) x[n] = y[n] = 'A' + random() % 26;
+    y[size - 1] ^= 0x20;  //differs in case only, at the end
+    auto t = x.data(), s = y.data();
+    measure("compare", size,
+      [&] { sink = memory::compare(t, s, size); },
+      [&] { sink = Loop::compare(t, size, s, size); });
+    measure("icompare", size,
+      [&] { sink = memory::icompare(t, s, size); },
+      [&] { sink = Loop::icompare(t, size, s, size); });
+    measure("copy", size,
+      [&] { memory::copy(t, s, size); sink = t[0]; },
+      [&] { Loop::copy(t, s, size); sink = t[0]; });
+    measure("move", size,
+      [&] { memory::move(t + 1, t, size); sink = t[1]; },
+      [&] { Loop::move(t + 1, t, size); sink = t[1]; });
+    measure("fill", size,
+      [&] { memory::fill<uint8_t>(t, size, 'a'); sink = t[0]; },
+      [&] { Loop::fill(t, size, 'a'); sink = t[0]; });
+  }
+}
@@ -113,6 +113,10 @@ auto pApplication::setScreenSaver(bool screenSaver) -> void {
   }
 }
 
+auto pApplication::watch(int descriptor, const function<void ()>& callback) -> bool {
+  return false;
+}
+
 auto pApplication::initialize() -> void {
   @autoreleasepool {
     [NSApplication sharedApplication];
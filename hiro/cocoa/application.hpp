@@ -18,6 +18,7 @@ struct pApplication {
   static auto processEvents() -> void;
   static auto quit() -> void;
   static auto setScreenSaver(bool screenSaver) -> void;
+  static auto watch(int descriptor, const function<void ()>& callback) -> bool;
 
   static auto initialize() -> void;
 };
@@ -7,6 +7,10 @@ auto pKeyboard::poll() -> vector<bool> {
   return result;
 }
 
+auto pKeyboard::polled() -> bool {
+  return true;
+}
+
 auto pKeyboard::pressed(uint code) -> bool {
   return false;
 }
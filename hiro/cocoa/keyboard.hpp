@@ -4,6 +4,7 @@ namespace hiro {
 
 struct pKeyboard {
   static auto poll() -> vector<bool>;
+  static auto polled() -> bool;
   static auto pressed(uint code) -> bool;
 };
 
@@ -26,7 +26,7 @@ auto pHexEdit::destruct() -> void {
   }
 }
 
-auto pHexEdit::setAddress(uint offset) -> void {
+auto pHexEdit::setAddress(uint64_t offset) -> void {
 }
 
 auto pHexEdit::setBackgroundColor(Color color) -> void {
@@ -38,7 +38,7 @@ auto pHexEdit::setColumns(uint columns) -> void {
 auto pHexEdit::setForegroundColor(Color color) -> void {
 }
 
-auto pHexEdit::setLength(uint length) -> void {
+auto pHexEdit::setLength(uint64_t length) -> void {
 }
 
 auto pHexEdit::setRows(uint rows) -> void {
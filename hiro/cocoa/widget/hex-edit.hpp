@@ -12,11 +12,11 @@ namespace hiro {
 struct pHexEdit : public pWidget {
   Declare(HexEdit, Widget);
 
-  auto setAddress(uint address) -> void;
+  auto setAddress(uint64_t address) -> void;
   auto setBackgroundColor(Color color) -> void;
   auto setColumns(uint columns) -> void;
   auto setForegroundColor(Color color) -> void;
-  auto setLength(uint length) -> void;
+  auto setLength(uint64_t length) -> void;
   auto setRows(uint rows) -> void;
   auto update() -> void;
 
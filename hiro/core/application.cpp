@@ -133,6 +133,13 @@ auto Application::Cocoa::onQuit(const function<void ()>& callback) -> void {
   state().cocoa.onQuit = callback;
 }
 
+//invokes callback from the event loop whenever descriptor has data to be read; an empty callback stops watching
+//callbacks run once pending input and redraws have been handled, so that a busy descriptor cannot stall the GUI
+//returns false when the platform cannot wait on descriptors, and descriptor must be polled instead
+auto Application::watch(int descriptor, const function<void ()>& callback) -> bool {
+  return pApplication::watch(descriptor, callback);
+}
+
 //Internal
 //========
 
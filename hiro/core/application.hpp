@@ -24,6 +24,7 @@ struct Application {
   static auto setToolTips(bool toolTips = true) -> void;
   static auto toolTips() -> bool;
   static auto unscale(float value) -> float;
+  static auto watch(int descriptor, const function<void ()>& callback = {}) -> bool;
 
   struct Cocoa {
     static auto doAbout() -> void;
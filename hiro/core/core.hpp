@@ -335,6 +335,7 @@ struct Keyboard {
   static auto hotkeyCount() -> uint;
   static auto hotkeys() -> vector<Hotkey>;
   static auto poll() -> vector<bool>;
+  static auto polled() -> bool;
   static auto pressed(const string& key) -> bool;
   static auto released(const string& key) -> bool;
   static auto remove(Hotkey hotkey) -> void;
@@ -342,6 +343,8 @@ struct Keyboard {
   static const vector<string> keys;
 
 //private:
+  static auto _update(const vector<bool>& pressed) -> void;
+
   struct State {
     vector<Hotkey> hotkeys;
   };
@@ -846,33 +849,33 @@ struct mFrame : mWidget {
 struct mHexEdit : mWidget {
   Declare(HexEdit)
 
-  auto address() const -> uint;
+  auto address() const -> uint64_t;
   auto backgroundColor() const -> Color;
   auto columns() const -> uint;
-  auto doRead(uint offset) const -> uint8_t;
-  auto doWrite(uint offset, uint8_t data) const -> void;
+  auto doRead(uint64_t offset) const -> uint8_t;
+  auto doWrite(uint64_t offset, uint8_t data) const -> void;
   auto foregroundColor() const -> Color;
-  auto length() const -> uint;
-  auto onRead(const function<uint8_t (uint)>& callback = {}) -> type&;
-  auto onWrite(const function<void (uint, uint8_t)>& callback = {}) -> type&;
+  auto length() const -> uint64_t;
+  auto onRead(const function<uint8_t (uint64_t)>& callback = {}) -> type&;
+  auto onWrite(const function<void (uint64_t, uint8_t)>& callback = {}) -> type&;
   auto rows() const -> uint;
-  auto setAddress(uint address = 0) -> type&;
+  auto setAddress(uint64_t address = 0) -> type&;
   auto setBackgroundColor(Color color = {}) -> type&;
   auto setColumns(uint columns = 16) -> type&;
   auto setForegroundColor(Color color = {}) -> type&;
-  auto setLength(uint length) -> type&;
+  auto setLength(uint64_t length) -> type&;
   auto setRows(uint rows = 16) -> type&;
   auto update() -> type&;
 
 //private:
   struct State {
-    uint address = 0;
+    uint64_t address = 0;
     Color backgroundColor;
     uint columns = 16;
     Color foregroundColor;
-    uint length = 0;
-    function<uint8_t (uint)> onRead;
-    function<void (uint, uint8_t)> onWrite;
+    uint64_t length = 0;
+    function<uint8_t (uint64_t)> onRead;
+    function<void (uint64_t, uint8_t)> onWrite;
     uint rows = 16;
   } state;
 };
@@ -44,23 +44,15 @@ auto Keyboard::hotkeys() -> vector<Hotkey> {
 
 auto Keyboard::poll() -> vector<bool> {
   auto pressed = pKeyboard::poll();
-
-  for(auto& hotkey : state.hotkeys) {
-    bool active = hotkey.state->sequence.size() > 0;
-    for(auto& key : hotkey.state->keys) {
-      if(pressed[key]) continue;
-      active = false;
-      break;
-    }
-    if(hotkey.state->active != active) {
-      hotkey.state->active = active;
-      active ? hotkey.doPress() : hotkey.doRelease();
-    }
-  }
-
+  _update(pressed);
   return pressed;
 }
 
+//when false, key events update hotkeys as they happen, and poll() need not be called
+auto Keyboard::polled() -> bool {
+  return pKeyboard::polled();
+}
+
 auto Keyboard::pressed(const string& key) -> bool {
   if(auto code = keys.find(key)) return pKeyboard::pressed(*code);
   return false;
@@ -76,4 +68,21 @@ auto Keyboard::remove(Hotkey hotkey) -> void {
   }
 }
 
+//
+
+auto Keyboard::_update(const vector<bool>& pressed) -> void {
+  for(auto& hotkey : state.hotkeys) {
+    bool active = hotkey.state->sequence.size() > 0;
+    for(auto& key : hotkey.state->keys) {
+      if(pressed[key]) continue;
+      active = false;
+      break;
+    }
+    if(hotkey.state->active != active) {
+      hotkey.state->active = active;
+      active ? hotkey.doPress() : hotkey.doRelease();
+    }
+  }
+}
+
 #endif
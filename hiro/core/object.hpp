@@ -52,20 +52,22 @@ struct mObject {
 
   //this template basically disables implicit template type deduction:
   //if setAttribute(name, value) is called without a type, the type will be a string, so attribute(name) will just work.
-  //if setAttribute<T>(name, value) is called, the type will be T. as such, U must be cast to T on assignment.
+  //if setAttribute<T>(name, value) is called, the type will be T. as such, U must be converted to T on assignment.
   //when T = string, value must be convertible to a string.
   //U defaults to a string, so that setAttribute(name, {values, ...}) will deduce U as a string.
   template<typename T = string, typename U = string> auto setAttribute(const string& name, const U& value) -> type& {
     if constexpr(std::is_same_v<T, string> && !std::is_same_v<U, string>) {
       return setAttribute(name, string{value});
-    }
-    if(auto attribute = state.attributes.find(name)) {
-      if((const T&)value) attribute->setValue((const T&)value);
-      else state.attributes.remove(*attribute);
     } else {
-      if((const T&)value) state.attributes.insert({name, (const T&)value});
+      const T& typed = value;  //a conversion, rather than a reinterpretation of U as T
+      if(auto attribute = state.attributes.find(name)) {
+        if(typed) attribute->setValue(typed);
+        else state.attributes.remove(*attribute);
+      } else {
+        if(typed) state.attributes.insert({name, typed});
+      }
+      return *this;
     }
-    return *this;
   }
 
 //private:
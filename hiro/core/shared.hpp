@@ -377,18 +377,18 @@ struct HexEdit : sHexEdit {
   auto address() const { return self().address(); }
   auto backgroundColor() const { return self().backgroundColor(); }
   auto columns() const { return self().columns(); }
-  auto doRead(unsigned offset) const { return self().doRead(offset); }
-  auto doWrite(unsigned offset, uint8_t data) const { return self().doWrite(offset, data); }
+  auto doRead(uint64_t offset) const { return self().doRead(offset); }
+  auto doWrite(uint64_t offset, uint8_t data) const { return self().doWrite(offset, data); }
   auto foregroundColor() const { return self().foregroundColor(); }
   auto length() const { return self().length(); }
-  auto onRead(const function<uint8_t (unsigned)>& callback = {}) { return self().onRead(callback), *this; }
-  auto onWrite(const function<void (unsigned, uint8_t)>& callback = {}) { return self().onWrite(callback), *this; }
+  auto onRead(const function<uint8_t (uint64_t)>& callback = {}) { return self().onRead(callback), *this; }
+  auto onWrite(const function<void (uint64_t, uint8_t)>& callback = {}) { return self().onWrite(callback), *this; }
   auto rows() const { return self().rows(); }
-  auto setAddress(unsigned address) { return self().setAddress(address), *this; }
+  auto setAddress(uint64_t address) { return self().setAddress(address), *this; }
   auto setBackgroundColor(Color color = {}) { return self().setBackgroundColor(color), *this; }
   auto setColumns(unsigned columns = 16) { return self().setColumns(columns), *this; }
   auto setForegroundColor(Color color = {}) { return self().setForegroundColor(color), *this; }
-  auto setLength(unsigned length) { return self().setLength(length), *this; }
+  auto setLength(uint64_t length) { return self().setLength(length), *this; }
   auto setRows(unsigned rows = 16) { return self().setRows(rows), *this; }
   auto update() { return self().update(), *this; }
 };
@@ -548,16 +548,30 @@ struct SourceEdit : sSourceEdit {
 
   auto doChange() const { return self().doChange(); }
   auto doMove() const { return self().doMove(); }
+  auto doSearch() const { return self().doSearch(); }
   auto editable() const { return self().editable(); }
   auto language() const { return self().language(); }
+  auto lineAt(uint offset) const { return self().lineAt(offset); }
+  auto lineCount() const { return self().lineCount(); }
+  auto lineOffset(uint line) const { return self().lineOffset(line); }
   auto numbered() const { return self().numbered(); }
   auto onChange(const function<void ()>& callback = {}) { return self().onChange(callback), *this; }
   auto onMove(const function<void ()>& callback = {}) { return self().onMove(callback), *this; }
+  auto onSearch(const function<void ()>& callback = {}) { return self().onSearch(callback), *this; }
   auto scheme() const { return self().scheme(); }
+  auto search() const { return self().search(); }
+  auto searchCase() const { return self().searchCase(); }
+  auto searchCount() const { return self().searchCount(); }
+  auto searchNext() { return self().searchNext(); }
+  auto searchPrevious() { return self().searchPrevious(); }
+  auto searchWholeWord() const { return self().searchWholeWord(); }
   auto setEditable(bool editable = true) { return self().setEditable(editable), *this; }
   auto setLanguage(const string& language = "") { return self().setLanguage(language), *this; }
   auto setNumbered(bool numbered = true) { return self().setNumbered(numbered), *this; }
   auto setScheme(const string& scheme = "") { return self().setScheme(scheme), *this; }
+  auto setSearch(const string& search = "") { return self().setSearch(search), *this; }
+  auto setSearchCase(bool searchCase = true) { return self().setSearchCase(searchCase), *this; }
+  auto setSearchWholeWord(bool searchWholeWord = true) { return self().setSearchWholeWord(searchWholeWord), *this; }
   auto setText(const string& text = "") { return self().setText(text), *this; }
   auto setTextCursor(TextCursor textCursor = {}) { return self().setTextCursor(textCursor), *this; }
   auto setWordWrap(bool wordWrap = true) { return self().setWordWrap(wordWrap), *this; }
@@ -786,6 +800,7 @@ struct TreeViewItem : sTreeViewItem {
   auto setIcon(const image& icon = {}) { return self().setIcon(icon), *this; }
   auto setSelected() { return self().setSelected(), *this; }
   auto setText(const string& text = "") { return self().setText(text), *this; }
+  auto sort(const function<bool (TreeViewItem, TreeViewItem)>& comparator) { return self().sort(comparator), *this; }
   auto text() const { return self().text(); }
 };
 #endif
@@ -818,6 +833,7 @@ struct TreeView : sTreeView {
   auto setActivation(Mouse::Click activation = Mouse::Click::Double) { return self().setActivation(activation), *this; }
   auto setBackgroundColor(Color color = {}) { return self().setBackgroundColor(color), *this; }
   auto setForegroundColor(Color color = {}) { return self().setForegroundColor(color), *this; }
+  auto sort(const function<bool (TreeViewItem, TreeViewItem)>& comparator) { return self().sort(comparator), *this; }
 };
 #endif
 
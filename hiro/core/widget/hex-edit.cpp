@@ -6,7 +6,7 @@ auto mHexEdit::allocate() -> pObject* {
 
 //
 
-auto mHexEdit::address() const -> unsigned {
+auto mHexEdit::address() const -> uint64_t {
   return state.address;
 }
 
@@ -18,12 +18,12 @@ auto mHexEdit::columns() const -> unsigned {
   return state.columns;
 }
 
-auto mHexEdit::doRead(unsigned offset) const -> uint8_t {
+auto mHexEdit::doRead(uint64_t offset) const -> uint8_t {
   if(state.onRead) return state.onRead(offset);
   return 0x00;
 }
 
-auto mHexEdit::doWrite(unsigned offset, uint8_t data) const -> void {
+auto mHexEdit::doWrite(uint64_t offset, uint8_t data) const -> void {
   if(state.onWrite) return state.onWrite(offset, data);
 }
 
@@ -31,16 +31,16 @@ auto mHexEdit::foregroundColor() const -> Color {
   return state.foregroundColor;
 }
 
-auto mHexEdit::length() const -> unsigned {
+auto mHexEdit::length() const -> uint64_t {
   return state.length;
 }
 
-auto mHexEdit::onRead(const function<uint8_t (unsigned)>& callback) -> type& {
+auto mHexEdit::onRead(const function<uint8_t (uint64_t)>& callback) -> type& {
   state.onRead = callback;
   return *this;
 }
 
-auto mHexEdit::onWrite(const function<void (unsigned, uint8_t)>& callback) -> type& {
+auto mHexEdit::onWrite(const function<void (uint64_t, uint8_t)>& callback) -> type& {
   state.onWrite = callback;
   return *this;
 }
@@ -49,7 +49,7 @@ auto mHexEdit::rows() const -> unsigned {
   return state.rows;
 }
 
-auto mHexEdit::setAddress(unsigned address) -> type& {
+auto mHexEdit::setAddress(uint64_t address) -> type& {
   state.address = address;
   signal(setAddress, address);
   return *this;
@@ -73,7 +73,7 @@ auto mHexEdit::setForegroundColor(Color color) -> type& {
   return *this;
 }
 
-auto mHexEdit::setLength(unsigned length) -> type& {
+auto mHexEdit::setLength(uint64_t length) -> type& {
   state.length = length;
   signal(setLength, length);
   return *this;
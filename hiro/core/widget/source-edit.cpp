@@ -14,6 +14,10 @@ auto mSourceEdit::doMove() const -> void {
   if(state.onMove) return state.onMove();
 }
 
+auto mSourceEdit::doSearch() const -> void {
+  if(state.onSearch) return state.onSearch();
+}
+
 auto mSourceEdit::editable() const -> bool {
   return state.editable;
 }
@@ -22,6 +26,20 @@ auto mSourceEdit::language() const -> string {
   return state.language;
 }
 
+//line containing the character at offset (0-based)
+auto mSourceEdit::lineAt(uint offset) const -> uint {
+  return signal(lineAt, offset);
+}
+
+auto mSourceEdit::lineCount() const -> uint {
+  return signal(lineCount);
+}
+
+//character offset of the start of line (0-based); lineCount() or greater returns the end of the text
+auto mSourceEdit::lineOffset(uint line) const -> uint {
+  return signal(lineOffset, line);
+}
+
 auto mSourceEdit::numbered() const -> bool {
   return state.numbered;
 }
@@ -36,10 +54,43 @@ auto mSourceEdit::onMove(const function<void ()>& callback) -> type& {
   return *this;
 }
 
+auto mSourceEdit::onSearch(const function<void ()>& callback) -> type& {
+  state.onSearch = callback;
+  return *this;
+}
+
 auto mSourceEdit::scheme() const -> string {
   return state.scheme;
 }
 
+auto mSourceEdit::search() const -> string {
+  return state.search;
+}
+
+auto mSourceEdit::searchCase() const -> bool {
+  return state.searchCase;
+}
+
+//number of matches of search() in the text, or -1 while they are still being counted
+//onSearch() is invoked whenever this changes
+auto mSourceEdit::searchCount() const -> int {
+  return signal(searchCount);
+}
+
+//selects the next match after the selection, wrapping around to the start of the text
+auto mSourceEdit::searchNext() -> bool {
+  return signal(searchNext);
+}
+
+//selects the last match before the selection, wrapping around to the end of the text
+auto mSourceEdit::searchPrevious() -> bool {
+  return signal(searchPrevious);
+}
+
+auto mSourceEdit::searchWholeWord() const -> bool {
+  return state.searchWholeWord;
+}
+
 auto mSourceEdit::setEditable(bool editable) -> type& {
   state.editable = editable;
   signal(setEditable, editable);
@@ -64,6 +115,25 @@ auto mSourceEdit::setScheme(const string& scheme) -> type& {
   return *this;
 }
 
+//every match of search is highlighted until it is cleared
+auto mSourceEdit::setSearch(const string& search) -> type& {
+  state.search = search;
+  signal(setSearch, search);
+  return *this;
+}
+
+auto mSourceEdit::setSearchCase(bool searchCase) -> type& {
+  state.searchCase = searchCase;
+  signal(setSearchCase, searchCase);
+  return *this;
+}
+
+auto mSourceEdit::setSearchWholeWord(bool searchWholeWord) -> type& {
+  state.searchWholeWord = searchWholeWord;
+  signal(setSearchWholeWord, searchWholeWord);
+  return *this;
+}
+
 auto mSourceEdit::setText(const string& text) -> type& {
   state.text = text;
   signal(setText, text);
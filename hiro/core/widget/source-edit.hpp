@@ -4,16 +4,30 @@ struct mSourceEdit : mWidget {
 
   auto doChange() const -> void;
   auto doMove() const -> void;
+  auto doSearch() const -> void;
   auto editable() const -> bool;
   auto language() const -> string;
+  auto lineAt(uint offset) const -> uint;
+  auto lineCount() const -> uint;
+  auto lineOffset(uint line) const -> uint;
   auto numbered() const -> bool;
   auto onChange(const function<void ()>& callback = {}) -> type&;
   auto onMove(const function<void ()>& callback = {}) -> type&;
+  auto onSearch(const function<void ()>& callback = {}) -> type&;
   auto scheme() const -> string;
+  auto search() const -> string;
+  auto searchCase() const -> bool;
+  auto searchCount() const -> int;
+  auto searchNext() -> bool;
+  auto searchPrevious() -> bool;
+  auto searchWholeWord() const -> bool;
   auto setEditable(bool editable) -> type&;
   auto setLanguage(const string& language = "") -> type&;
   auto setNumbered(bool numbered = true) -> type&;
   auto setScheme(const string& scheme = "") -> type&;
+  auto setSearch(const string& search = "") -> type&;
+  auto setSearchCase(bool searchCase = true) -> type&;
+  auto setSearchWholeWord(bool searchWholeWord = true) -> type&;
   auto setText(const string& text = "") -> type&;
   auto setTextCursor(TextCursor textCursor = {}) -> type&;
   auto setWordWrap(bool wordWrap = true) -> type&;
@@ -28,7 +42,11 @@ struct mSourceEdit : mWidget {
     bool numbered = true;
     function<void ()> onChange;
     function<void ()> onMove;
+    function<void ()> onSearch;
     string scheme;
+    string search;
+    bool searchCase = false;
+    bool searchWholeWord = false;
     string text;
     TextCursor textCursor;
     bool wordWrap = true;
@@ -178,6 +178,18 @@ auto mTreeViewItem::setText(const string& text) -> type& {
   return *this;
 }
 
+//reorders the items in place: unlike removing and appending them again, expansion and selection are kept
+auto mTreeViewItem::sort(const function<bool (TreeViewItem lhs, TreeViewItem rhs)>& comparator) -> type& {
+  state.items.sort([&](auto& lhs, auto& rhs) { return comparator(lhs, rhs); });
+  vector<int> order;  //the previous offset of each item, in its new order
+  for(uint n : range(itemCount())) {
+    order.append(state.items[n]->offset());
+    state.items[n]->adjustOffset((int)n - state.items[n]->offset());
+  }
+  signal(sort, order);
+  return *this;
+}
+
 auto mTreeViewItem::text() const -> string {
   return state.text;
 }
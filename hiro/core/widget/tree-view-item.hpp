@@ -28,6 +28,7 @@ struct mTreeViewItem : mObject {
   auto setParent(mObject* parent = nullptr, int offset = -1) -> type&;
   auto setSelected() -> type&;
   auto setText(const string& text = "") -> type&;
+  auto sort(const function<bool (TreeViewItem lhs, TreeViewItem rhs)>& comparator) -> type&;
   auto text() const -> string;
 
 //private:
@@ -148,4 +148,16 @@ auto mTreeView::setParent(mObject* object, signed offset) -> type& {
   return *this;
 }
 
+//see mTreeViewItem::sort()
+auto mTreeView::sort(const function<bool (TreeViewItem lhs, TreeViewItem rhs)>& comparator) -> type& {
+  state.items.sort([&](auto& lhs, auto& rhs) { return comparator(lhs, rhs); });
+  vector<int> order;
+  for(uint n : range(itemCount())) {
+    order.append(state.items[n]->offset());
+    state.items[n]->adjustOffset((int)n - state.items[n]->offset());
+  }
+  signal(sort, order);
+  return *this;
+}
+
 #endif
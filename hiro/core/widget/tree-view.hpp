@@ -28,6 +28,7 @@ struct mTreeView : mWidget {
   auto setBackgroundColor(Color color = {}) -> type&;
   auto setForegroundColor(Color color = {}) -> type&;
   auto setParent(mObject* parent = nullptr, int offset = -1) -> type&;
+  auto sort(const function<bool (TreeViewItem lhs, TreeViewItem rhs)>& comparator) -> type&;
 
 //private:
   struct State {
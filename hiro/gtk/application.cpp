@@ -15,6 +15,11 @@ auto Log_Filter(const char* logDomain, GLogLevelFlags logLevel, const char* mess
   print(terminal::color::yellow("hiro: "), logDomain, "::", message, "\n");
 }
 
+static auto Application_watch(GIOChannel*, GIOCondition, function<void ()>* callback) -> int {
+  if(!Application::state().quit) (*callback)();
+  return true;
+}
+
 auto pApplication::exit() -> void {
   quit();
   ::exit(EXIT_SUCCESS);
@@ -25,13 +30,17 @@ auto pApplication::modal() -> bool {
 }
 
 auto pApplication::run() -> void {
-  while(!Application::state().quit) {
-    Application::doMain();
-    processEvents();
-    //avoid spinlooping the thread when there is no main loop ...
-    //when there is one, Application::onMain() is expected to sleep when possible instead
-    if(!Application::state().onMain) usleep(2000);
+  //applications with a main loop are polled: Application::onMain() is expected to sleep when possible
+  if(Application::state().onMain) {
+    while(!Application::state().quit) {
+      Application::doMain();
+      processEvents();
+    }
+    return;
   }
+
+  //otherwise, sleep until an event, timer or watched descriptor needs attention
+  if(!Application::state().quit) gtk_main();
 }
 
 auto pApplication::pendingEvents() -> bool {
@@ -75,6 +84,25 @@ auto pApplication::setScreenSaver(bool screenSaver) -> void {
   #endif
 }
 
+auto pApplication::watch(int descriptor, const function<void ()>& callback) -> bool {
+  if(auto source = state().watches.find(descriptor)) {
+    g_source_remove(source());
+    state().watches.remove(descriptor);
+  }
+  if(!callback) return true;
+  #if defined(DISPLAY_XORG)
+  if(descriptor < 0) return false;
+  auto channel = g_io_channel_unix_new(descriptor);
+  uint source = g_io_add_watch_full(channel, G_PRIORITY_DEFAULT_IDLE, G_IO_IN, (GIOFunc)Application_watch,
+    new function<void ()>(callback), [](gpointer callback) { delete (function<void ()>*)callback; });
+  g_io_channel_unref(channel);  //the watch holds its own reference
+  state().watches.insert(descriptor, source);
+  return true;
+  #else
+  return false;
+  #endif
+}
+
 auto pApplication::state() -> State& {
   static State state;
   return state;
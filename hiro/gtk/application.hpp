@@ -10,11 +10,13 @@ struct pApplication {
   static auto processEvents() -> void;
   static auto quit() -> void;
   static auto setScreenSaver(bool screenSaver) -> void;
+  static auto watch(int descriptor, const function<void ()>& callback) -> bool;
 
   static auto initialize() -> void;
 
   struct State {
     vector<pWindow*> windows;
+    map<int, uint> watches;  //descriptor => GSource ID
 
     #if defined(DISPLAY_XORG)
     XlibDisplay* display = nullptr;
@@ -17,6 +17,7 @@
   #if defined(Hiro_SourceEdit)
     #if HIRO_GTK==2
       #include <gtksourceview/gtksourceview.h>
+      #include <gtksourceview/gtksourceiter.h>
       #include <gtksourceview/gtksourcelanguagemanager.h>
       #include <gtksourceview/gtksourcestyleschememanager.h>
     #elif HIRO_GTK==3
@@ -39,6 +40,7 @@
   #if defined(Hiro_SourceEdit)
     #if HIRO_GTK==2
       #include <gtksourceview/gtksourceview.h>
+      #include <gtksourceview/gtksourceiter.h>
       #include <gtksourceview/gtksourcelanguagemanager.h>
       #include <gtksourceview/gtksourcestyleschememanager.h>
     #elif HIRO_GTK==3
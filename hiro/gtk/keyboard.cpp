@@ -16,6 +16,11 @@ auto pKeyboard::poll() -> vector<bool> {
   return result;
 }
 
+//hotkeys are updated by the key events of every Window
+auto pKeyboard::polled() -> bool {
+  return false;
+}
+
 auto pKeyboard::pressed(uint code) -> bool {
   char state[256];
   #if defined(DISPLAY_XORG)
@@ -24,6 +29,26 @@ auto pKeyboard::pressed(uint code) -> bool {
   return _pressed(state, code);
 }
 
+//keycode is the hardware keycode of a key press or release event
+auto pKeyboard::_event(uint16_t keycode, bool pressed) -> void {
+  if(Application::state().quit) return;
+
+  char state[256] = {};
+  #if defined(DISPLAY_XORG)
+  XQueryKeymap(pApplication::state().display, state);
+  //a quickly tapped key may already be up again: trust the event for its own key
+  if(keycode < 256) {
+    if(pressed) state[keycode >> 3] |= 1 << (keycode & 7);
+    else state[keycode >> 3] &= ~(1 << (keycode & 7));
+  }
+  #endif
+  vector<bool> result;
+  for(auto& code : settings.keycodes) {
+    result.append(_pressed(state, code));
+  }
+  Keyboard::_update(result);
+}
+
 auto pKeyboard::_pressed(const char* state, uint16_t code) -> bool {
   uint8_t lo = code >> 0;
   uint8_t hi = code >> 8;
@@ -4,8 +4,10 @@ namespace hiro {
 
 struct pKeyboard {
   static auto poll() -> vector<bool>;
+  static auto polled() -> bool;
   static auto pressed(uint code) -> bool;
 
+  static auto _event(uint16_t keycode, bool pressed) -> void;
   static auto _pressed(const char* state, uint16_t code) -> bool;
   static auto _translate(uint code) -> signed;
 
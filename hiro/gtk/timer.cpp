@@ -2,19 +2,23 @@
 
 namespace hiro {
 
+//each enabled timer owns exactly one GSource, which is removed as soon as the timer is disabled,
+//so that a disabled timer never wakes the event loop again
 static auto Timer_trigger(pTimer* p) -> int {
   //prevent all timers from firing once the program has been terminated
-  if(Application::state().quit) return false;
+  if(Application::state().quit) {
+    if(p->source == g_source_get_id(g_main_current_source())) p->source = 0;
+    return false;
+  }
 
   //timer may have been disabled prior to triggering, so check state
   if(p->self().enabled(true)) p->self().doActivate();
 
-  //callback may have disabled timer, so check state again
-  if(p->self().enabled(true)) {
-    g_timeout_add(p->state().interval, (GSourceFunc)Timer_trigger, (gpointer)p);
-  }
+  //callback may have disabled timer, or disabled and enabled it again: then another source has replaced this one
+  if(p->source != g_source_get_id(g_main_current_source())) return false;
+  if(p->self().enabled(true)) return true;
 
-  //kill this timer instance (it is spawned above if needed again)
+  p->source = 0;
   return false;
 }
 
@@ -22,15 +26,20 @@ auto pTimer::construct() -> void {
 }
 
 auto pTimer::destruct() -> void {
+  if(source) g_source_remove(source);
+  source = 0;
 }
 
 auto pTimer::setEnabled(bool enabled) -> void {
-  if(enabled) {
-    g_timeout_add(state().interval, (GSourceFunc)Timer_trigger, (gpointer)this);
-  }
+  if(enabled && source) return;  //already running
+  if(source) g_source_remove(source);
+  source = enabled ? g_timeout_add(state().interval, (GSourceFunc)Timer_trigger, (gpointer)this) : 0;
 }
 
 auto pTimer::setInterval(uint interval) -> void {
+  if(!source) return;
+  g_source_remove(source);
+  source = g_timeout_add(interval, (GSourceFunc)Timer_trigger, (gpointer)this);
 }
 
 }
@@ -7,6 +7,8 @@ struct pTimer : pObject {
 
   auto setEnabled(bool enabled) -> void override;
   auto setInterval(uint interval) -> void;
+
+  uint source = 0;  //GSource ID while enabled
 };
 
 }
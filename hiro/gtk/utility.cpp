@@ -11,9 +11,31 @@ static auto CreateColor(const Color& color) -> GdkColor {
 }
 #endif
 
+//small icons are mostly stock resources set on many widgets at once: they share one pixbuf each
+struct PixbufCache {
+  auto hash() const -> uint {
+    return Hash::CRC32({icon.data(), icon.size()}).value() ^ scale;
+  }
+
+  auto operator==(const PixbufCache& source) const -> bool {
+    return scale == source.scale && icon == source.icon;
+  }
+
+  image icon;
+  bool scale = false;
+  GdkPixbuf* pixbuf = nullptr;
+};
+
 static auto CreatePixbuf(image icon, bool scale = false) -> GdkPixbuf* {
   if(!icon) return nullptr;
 
+  static hashset<PixbufCache> cache;
+  bool cacheable = icon.width() <= 64 && icon.height() <= 64;
+  if(cacheable) {
+    if(auto cached = cache.find({icon, scale})) return (GdkPixbuf*)g_object_ref(cached().pixbuf);
+  }
+  PixbufCache entry{cacheable ? icon : image{}, scale};
+
   if(scale) icon.scale(15, 15);
   icon.transform(0, 32, 255u << 24, 255u << 0, 255u << 8, 255u << 16);  //GTK stores images in ABGR format
 
@@ -26,6 +48,10 @@ static auto CreatePixbuf(image icon, bool scale = false) -> GdkPixbuf* {
     pixbuf = scaled;
   }
 
+  if(cacheable) {
+    entry.pixbuf = (GdkPixbuf*)g_object_ref(pixbuf);  //held for the lifetime of the process
+    cache.insert(entry);
+  }
   return pixbuf;
 }
 
@@ -7,7 +7,7 @@ static auto HexEdit_keyPress(GtkWidget* widget, GdkEventKey* event, pHexEdit* p)
 }
 
 static auto HexEdit_mouseScroll(GtkWidget* widget, GdkEventScroll* event, pHexEdit* p) -> int {
-  double position = gtk_range_get_value(GTK_RANGE(p->scrollBar));
+  int64_t position = gtk_range_get_value(GTK_RANGE(p->scrollBar));
 
   if(event->direction == GDK_SCROLL_UP) {
     p->scroll(position - 1);
@@ -21,7 +21,7 @@ static auto HexEdit_mouseScroll(GtkWidget* widget, GdkEventScroll* event, pHexEd
 }
 
 static auto HexEdit_scroll(GtkRange* range, GtkScrollType scroll, double value, pHexEdit* p) -> int {
-  p->scroll((int)value);
+  p->scroll((int64_t)value);
   return true;  //do not propagate event further
 }
 
@@ -88,7 +88,7 @@ auto pHexEdit::focused() const -> bool {
   return gtk_widget_has_focus(subWidget) || gtk_widget_has_focus(scrollBar);
 }
 
-auto pHexEdit::setAddress(uint address) -> void {
+auto pHexEdit::setAddress(uint64_t address) -> void {
   setScroll();
   updateScroll();
   update();
@@ -109,7 +109,7 @@ auto pHexEdit::setForegroundColor(Color color) -> void {
   gtk_widget_modify_text(subWidget, GTK_STATE_NORMAL, color ? &gdkColor : nullptr);
 }
 
-auto pHexEdit::setLength(uint length) -> void {
+auto pHexEdit::setLength(uint64_t length) -> void {
   setScroll();
   update();
 }
@@ -128,9 +128,9 @@ auto pHexEdit::update() -> void {
   uint position = cursorPosition();
 
   string output;
-  uint address = state().address;
+  uint64_t address = state().address;
   for(auto row : range(state().rows)) {
-    output.append(hex(address, 8L));
+    output.append(hex(address, addressWidth()));
     output.append("  ");
 
     string hexdata;
@@ -154,10 +154,15 @@ auto pHexEdit::update() -> void {
   }
 
   gtk_text_buffer_set_text(textBuffer, output, -1);
-  if(position == 0) position = 10;  //start at first position where hex values can be entered
+  if(position == 0) position = addressWidth() + 2;  //start at first position where hex values can be entered
   setCursorPosition(position);
 }
 
+//number of digits used to display addresses
+auto pHexEdit::addressWidth() const -> uint {
+  return state().length > 0x100000000ull ? 12 : 8;
+}
+
 auto pHexEdit::cursorPosition() -> uint {
   GtkTextIter iter;
   gtk_text_buffer_get_iter_at_mark(textBuffer, &iter, textCursor);
@@ -170,24 +175,25 @@ auto pHexEdit::keyPress(uint scancode, uint mask) -> bool {
   if(mask & (GDK_CONTROL_MASK | GDK_MOD1_MASK | GDK_SUPER_MASK)) return false;  //allow actions such as Ctrl+C (copy)
 
   int position = cursorPosition();
-  int lineWidth = 10 + (state().columns * 3) + 1 + state().columns + 1;
+  int offsetWidth = addressWidth() + 2;
+  int lineWidth = offsetWidth + (state().columns * 3) + 1 + state().columns + 1;
   int cursorY = position / lineWidth;
   int cursorX = position % lineWidth;
 
   if(scancode == GDK_KEY_Home) {
-    setCursorPosition(cursorY * lineWidth + 10);
+    setCursorPosition(cursorY * lineWidth + offsetWidth);
     return true;
   }
 
   if(scancode == GDK_KEY_End) {
-    setCursorPosition(cursorY * lineWidth + 10 + (state().columns * 3 - 1));
+    setCursorPosition(cursorY * lineWidth + offsetWidth + (state().columns * 3 - 1));
     return true;
   }
 
   if(scancode == GDK_KEY_Up) {
     if(cursorY != 0) return false;
 
-    int newAddress = state().address - state().columns;
+    int64_t newAddress = state().address - state().columns;
     if(newAddress >= 0) {
       self().setAddress(newAddress);
       update();
@@ -199,7 +205,7 @@ auto pHexEdit::keyPress(uint scancode, uint mask) -> bool {
     if(cursorY >= rows() - 1) return true;
     if(cursorY != state().rows - 1) return false;
 
-    int newAddress = state().address + state().columns;
+    int64_t newAddress = state().address + state().columns;
     if(newAddress + state().columns * state().rows - (state().columns - 1) <= state().length) {
       self().setAddress(newAddress);
       update();
@@ -208,7 +214,7 @@ auto pHexEdit::keyPress(uint scancode, uint mask) -> bool {
   }
 
   if(scancode == GDK_KEY_Page_Up) {
-    int newAddress = state().address - state().columns * state().rows;
+    int64_t newAddress = state().address - state().columns * state().rows;
     if(newAddress >= 0) {
       self().setAddress(newAddress);
     } else {
@@ -219,7 +225,7 @@ auto pHexEdit::keyPress(uint scancode, uint mask) -> bool {
   }
 
   if(scancode == GDK_KEY_Page_Down) {
-    int newAddress = state().address + state().columns * state().rows;
+    int64_t newAddress = state().address + state().columns * state().rows;
     for(auto n : range(state().rows)) {
       if(newAddress + state().columns * state().rows - (state().columns - 1) <= state().length) {
         self().setAddress(newAddress);
@@ -237,16 +243,16 @@ auto pHexEdit::keyPress(uint scancode, uint mask) -> bool {
   else if(scancode >= 'a' && scancode <= 'f') scancode = scancode - 'a' + 10;
   else return false;  //not a valid hex value
 
-  if(cursorX >= 10) {
+  if(cursorX >= offsetWidth) {
     //not on an offset
-    cursorX -= 10;
+    cursorX -= offsetWidth;
     if((cursorX % 3) != 2) {
       //not on a space
       bool cursorNibble = (cursorX % 3) == 1;  //0 = high, 1 = low
       cursorX /= 3;
       if(cursorX < state().columns) {
         //not in ANSI region
-        uint address = state().address + (cursorY * state().columns + cursorX);
+        uint64_t address = state().address + (cursorY * state().columns + cursorX);
 
         if(address >= state().length) return false;  //do not edit past end of data
         uint8_t data = self().doRead(address);
@@ -274,16 +280,16 @@ auto pHexEdit::keyPress(uint scancode, uint mask) -> bool {
 }
 
 //number of actual rows
-auto pHexEdit::rows() -> int {
-  return (max(1u, state().length) + state().columns - 1) / state().columns;
+auto pHexEdit::rows() -> int64_t {
+  return (max((uint64_t)1, state().length) + state().columns - 1) / state().columns;
 }
 
 //number of scrollable row positions
-auto pHexEdit::rowsScrollable() -> int {
-  return max(0u, rows() - state().rows);
+auto pHexEdit::rowsScrollable() -> int64_t {
+  return max((int64_t)0, rows() - (int64_t)state().rows);
 }
 
-auto pHexEdit::scroll(int position) -> void {
+auto pHexEdit::scroll(int64_t position) -> void {
   if(position > rowsScrollable()) position = rowsScrollable();
   if(position < 0) position = 0;
   self().setAddress(position * state().columns);
@@ -312,7 +318,7 @@ auto pHexEdit::setScroll() -> void {
 }
 
 auto pHexEdit::updateScroll() -> void {
-  uint row = state().address / state().columns;
+  uint64_t row = state().address / state().columns;
   gtk_range_set_value(GTK_RANGE(scrollBar), row);
 }
 
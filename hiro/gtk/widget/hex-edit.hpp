@@ -6,19 +6,20 @@ struct pHexEdit : pWidget {
   Declare(HexEdit, Widget)
 
   auto focused() const -> bool override;
-  auto setAddress(uint address) -> void;
+  auto setAddress(uint64_t address) -> void;
   auto setBackgroundColor(Color color) -> void;
   auto setColumns(uint columns) -> void;
   auto setForegroundColor(Color color) -> void;
-  auto setLength(uint length) -> void;
+  auto setLength(uint64_t length) -> void;
   auto setRows(uint rows) -> void;
   auto update() -> void;
 
+  auto addressWidth() const -> uint;
   auto cursorPosition() -> uint;
   auto keyPress(uint scancode, uint mask) -> bool;
-  auto rows() -> int;
-  auto rowsScrollable() -> int;
-  auto scroll(int position) -> void;
+  auto rows() -> int64_t;
+  auto rowsScrollable() -> int64_t;
+  auto scroll(int64_t position) -> void;
   auto setCursorPosition(uint position) -> void;
   auto setScroll() -> void;
   auto updateScroll() -> void;
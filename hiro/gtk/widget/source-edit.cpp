@@ -3,6 +3,9 @@
 namespace hiro {
 
 static auto SourceEdit_change(GtkTextBuffer*, pSourceEdit* p) -> void {
+  #if HIRO_GTK==2
+  if(p->state().search) p->_searchRestart();
+  #endif
   if(!p->locked()) p->self().doChange();
 }
 
@@ -11,6 +14,16 @@ static auto SourceEdit_move(GObject*, GParamSpec*, pSourceEdit* p) -> void {
   if(!p->locked()) p->self().doMove();
 }
 
+#if HIRO_GTK==2
+static auto SourceEdit_searchSlice(pSourceEdit* p) -> gboolean {
+  return p->_searchSlice();
+}
+#elif HIRO_GTK==3
+static auto SourceEdit_search(GObject*, GParamSpec*, pSourceEdit* p) -> void {
+  p->self().doSearch();
+}
+#endif
+
 auto pSourceEdit::construct() -> void {
   gtkScrolledWindow = (GtkScrolledWindow*)gtk_scrolled_window_new(0, 0);
   gtkContainer = GTK_CONTAINER(gtkScrolledWindow);
@@ -31,6 +44,16 @@ auto pSourceEdit::construct() -> void {
   gtk_source_buffer_set_language(gtkSourceBuffer, gtkSourceLanguage);
   gtk_source_buffer_set_style_scheme(gtkSourceBuffer, gtkSourceStyleScheme);
 
+  #if HIRO_GTK==2
+  gtkTextTagSearch = gtk_text_buffer_create_tag(gtkTextBuffer, nullptr, "background", "#ffff80", "foreground", "#000000", nullptr);
+  #elif HIRO_GTK==3
+  //the search context counts and highlights matches in idle callbacks, and keeps them current as the text is edited
+  gtkSourceSearchSettings = gtk_source_search_settings_new();
+  gtk_source_search_settings_set_wrap_around(gtkSourceSearchSettings, true);
+  gtkSourceSearchContext = gtk_source_search_context_new(gtkSourceBuffer, gtkSourceSearchSettings);
+  gtk_source_search_context_set_highlight(gtkSourceSearchContext, true);
+  #endif
+
   gtkSourceView = (GtkSourceView*)gtk_source_view_new_with_buffer(gtkSourceBuffer);
   gtkTextView = GTK_TEXT_VIEW(gtkSourceView);
   gtkWidgetSourceView = GTK_WIDGET(gtkSourceView);
@@ -53,22 +76,99 @@ auto pSourceEdit::construct() -> void {
   setLanguage(state().language);
   setNumbered(state().numbered);
   setScheme(state().scheme);
+  setSearchCase(state().searchCase);
+  setSearchWholeWord(state().searchWholeWord);
   setText(state().text);
   setTextCursor(state().textCursor);
   setWordWrap(state().wordWrap);
+  setSearch(state().search);
 
   g_signal_connect(G_OBJECT(gtkSourceBuffer), "changed", G_CALLBACK(SourceEdit_change), (gpointer)this);
   g_signal_connect(G_OBJECT(gtkSourceBuffer), "notify::cursor-position", G_CALLBACK(SourceEdit_move), (gpointer)this);
+  #if HIRO_GTK==3
+  g_signal_connect(G_OBJECT(gtkSourceSearchContext), "notify::occurrences-count", G_CALLBACK(SourceEdit_search), (gpointer)this);
+  #endif
 
   pWidget::construct();
 }
 
 auto pSourceEdit::destruct() -> void {
   state().text = text();
+  #if HIRO_GTK==2
+  if(searchSource) g_source_remove(searchSource);
+  #elif HIRO_GTK==3
+  g_object_unref(gtkSourceSearchContext);
+  g_object_unref(gtkSourceSearchSettings);
+  #endif
   gtk_widget_destroy(gtkWidgetSourceView);
   gtk_widget_destroy(gtkWidget);
 }
 
+//GtkTextBuffer keeps its lines in a B-tree that is updated as text is inserted and deleted,
+//so these are O(log n) and never need to copy the buffer
+auto pSourceEdit::lineAt(uint offset) const -> uint {
+  GtkTextIter iter;
+  gtk_text_buffer_get_iter_at_offset(gtkTextBuffer, &iter, offset);
+  return gtk_text_iter_get_line(&iter);
+}
+
+auto pSourceEdit::lineCount() const -> uint {
+  return gtk_text_buffer_get_line_count(gtkTextBuffer);
+}
+
+auto pSourceEdit::lineOffset(uint line) const -> uint {
+  GtkTextIter iter;
+  if(line < lineCount()) {
+    gtk_text_buffer_get_iter_at_line(gtkTextBuffer, &iter, line);
+  } else {
+    gtk_text_buffer_get_end_iter(gtkTextBuffer, &iter);
+  }
+  return gtk_text_iter_get_offset(&iter);
+}
+
+auto pSourceEdit::searchCount() const -> int {
+  if(!state().search) return 0;
+  #if HIRO_GTK==2
+  return searchFinished ? (int)searchFound : -1;
+  #elif HIRO_GTK==3
+  return gtk_source_search_context_get_occurrences_count(gtkSourceSearchContext);
+  #endif
+}
+
+auto pSourceEdit::searchNext() -> bool {
+  if(!state().search) return false;
+  GtkTextIter origin, from, start, end;
+  gtk_text_buffer_get_selection_bounds(gtkTextBuffer, &origin, &from);
+  #if HIRO_GTK==2
+  bool found = _searchMatch(&from, &start, &end, nullptr, true);
+  if(!found) {
+    gtk_text_buffer_get_start_iter(gtkTextBuffer, &from);
+    found = _searchMatch(&from, &start, &end, nullptr, true);
+  }
+  #elif HIRO_GTK==3
+  bool found = gtk_source_search_context_forward(gtkSourceSearchContext, &from, &start, &end);
+  #endif
+  if(found) _searchSelect(&start, &end);
+  return found;
+}
+
+auto pSourceEdit::searchPrevious() -> bool {
+  if(!state().search) return false;
+  GtkTextIter from, origin, start, end;
+  gtk_text_buffer_get_selection_bounds(gtkTextBuffer, &from, &origin);
+  #if HIRO_GTK==2
+  bool found = _searchMatch(&from, &start, &end, nullptr, false);
+  if(!found) {
+    gtk_text_buffer_get_end_iter(gtkTextBuffer, &from);
+    found = _searchMatch(&from, &start, &end, nullptr, false);
+  }
+  #elif HIRO_GTK==3
+  bool found = gtk_source_search_context_backward(gtkSourceSearchContext, &from, &start, &end);
+  #endif
+  if(found) _searchSelect(&start, &end);
+  return found;
+}
+
 auto pSourceEdit::setEditable(bool editable) -> void {
   gtk_text_view_set_editable(gtkTextView, editable);
 }
@@ -97,6 +197,30 @@ auto pSourceEdit::setScheme(const string& requestedScheme) -> void {
   gtk_source_buffer_set_style_scheme(gtkSourceBuffer, gtkSourceStyleScheme);
 }
 
+auto pSourceEdit::setSearch(const string& search) -> void {
+  #if HIRO_GTK==2
+  _searchRestart();
+  #elif HIRO_GTK==3
+  gtk_source_search_settings_set_search_text(gtkSourceSearchSettings, search ? (const char*)search : nullptr);
+  #endif
+}
+
+auto pSourceEdit::setSearchCase(bool searchCase) -> void {
+  #if HIRO_GTK==2
+  if(state().search) _searchRestart();
+  #elif HIRO_GTK==3
+  gtk_source_search_settings_set_case_sensitive(gtkSourceSearchSettings, searchCase);
+  #endif
+}
+
+auto pSourceEdit::setSearchWholeWord(bool searchWholeWord) -> void {
+  #if HIRO_GTK==2
+  if(state().search) _searchRestart();
+  #elif HIRO_GTK==3
+  gtk_source_search_settings_set_at_word_boundaries(gtkSourceSearchSettings, searchWholeWord);
+  #endif
+}
+
 auto pSourceEdit::setText(const string& text) -> void {
   lock();
   //prevent Ctrl+Z from undoing the newly assigned text ...
@@ -156,6 +280,68 @@ auto pSourceEdit::textCursor() const -> TextCursor {
   return cursor;
 }
 
+//
+
+auto pSourceEdit::_searchSelect(GtkTextIter* start, GtkTextIter* end) -> void {
+  int offset = gtk_text_iter_get_offset(start);
+  setTextCursor({offset, gtk_text_iter_get_offset(end) - offset});
+}
+
+#if HIRO_GTK==2
+//gtksourceview 2 has no search context: matches are found with GtkSourceIter,
+//and highlighted by an idle callback that scans a slice of the text at a time
+
+auto pSourceEdit::_searchMatch(const GtkTextIter* from, GtkTextIter* start, GtkTextIter* end, const GtkTextIter* limit, bool forward) const -> bool {
+  auto flags = state().searchCase ? (GtkSourceSearchFlags)0 : GTK_SOURCE_SEARCH_CASE_INSENSITIVE;
+  GtkTextIter iter = *from;
+  while(forward
+  ? gtk_source_iter_forward_search(&iter, state().search, flags, start, end, limit)
+  : gtk_source_iter_backward_search(&iter, state().search, flags, start, end, limit)
+  ) {
+    if(!state().searchWholeWord || (gtk_text_iter_starts_word(start) && gtk_text_iter_ends_word(end))) return true;
+    iter = *start;
+    if(forward) gtk_text_iter_forward_char(&iter);
+  }
+  return false;
+}
+
+auto pSourceEdit::_searchRestart() -> void {
+  GtkTextIter start, end;
+  gtk_text_buffer_get_bounds(gtkTextBuffer, &start, &end);
+  gtk_text_buffer_remove_tag(gtkTextBuffer, gtkTextTagSearch, &start, &end);
+  if(searchSource) g_source_remove(searchSource);
+  searchSource = 0;
+  searchOffset = 0;
+  searchFound = 0;
+  searchFinished = !state().search;
+  if(!searchFinished) searchSource = g_idle_add((GSourceFunc)SourceEdit_searchSlice, (gpointer)this);
+  self().doSearch();
+}
+
+auto pSourceEdit::_searchSlice() -> bool {
+  static constexpr int Slice = 65536;  //characters scanned per idle callback
+  GtkTextIter iter, limit, start, end;
+  gtk_text_buffer_get_iter_at_offset(gtkTextBuffer, &iter, searchOffset);
+  limit = iter;
+  gtk_text_iter_forward_chars(&limit, Slice);
+  while(_searchMatch(&iter, &start, &end, &limit, true)) {
+    gtk_text_buffer_apply_tag(gtkTextBuffer, gtkTextTagSearch, &start, &end);
+    searchFound++;
+    iter = end;
+  }
+  if(gtk_text_iter_is_end(&limit)) {
+    searchSource = 0;
+    searchFinished = true;
+    self().doSearch();
+    return false;
+  }
+  //matches must end at or before limit, so the next slice overlaps this one by a match length
+  int overlap = state().search.characters() - 1;
+  searchOffset = max(gtk_text_iter_get_offset(&iter), gtk_text_iter_get_offset(&limit) - overlap);
+  return true;
+}
+#endif
+
 }
 
 #endif
@@ -5,17 +5,33 @@ namespace hiro {
 struct pSourceEdit : pWidget {
   Declare(SourceEdit, Widget)
 
+  auto lineAt(uint offset) const -> uint;
+  auto lineCount() const -> uint;
+  auto lineOffset(uint line) const -> uint;
   auto setEditable(bool editable) -> void;
   auto setFocused() -> void override;
   auto setLanguage(const string& language) -> void;
   auto setNumbered(bool numbered) -> void;
+  auto searchCount() const -> int;
+  auto searchNext() -> bool;
+  auto searchPrevious() -> bool;
   auto setScheme(const string& scheme) -> void;
+  auto setSearch(const string& search) -> void;
+  auto setSearchCase(bool searchCase) -> void;
+  auto setSearchWholeWord(bool searchWholeWord) -> void;
   auto setText(const string& text) -> void;
   auto setTextCursor(TextCursor textCursor) -> void;
   auto setWordWrap(bool wordWrap) -> void;
   auto text() const -> string;
   auto textCursor() const -> TextCursor;
 
+  auto _searchSelect(GtkTextIter* start, GtkTextIter* end) -> void;
+  #if HIRO_GTK==2
+  auto _searchMatch(const GtkTextIter* from, GtkTextIter* start, GtkTextIter* end, const GtkTextIter* limit, bool forward) const -> bool;
+  auto _searchRestart() -> void;
+  auto _searchSlice() -> bool;
+  #endif
+
   GtkScrolledWindow* gtkScrolledWindow = nullptr;
   GtkContainer* gtkContainer = nullptr;
   GtkSourceBuffer* gtkSourceBuffer = nullptr;
@@ -27,6 +43,16 @@ struct pSourceEdit : pWidget {
   GtkSourceView* gtkSourceView = nullptr;
   GtkTextView* gtkTextView = nullptr;
   GtkWidget* gtkWidgetSourceView = nullptr;
+  #if HIRO_GTK==2
+  GtkTextTag* gtkTextTagSearch = nullptr;
+  uint searchSource = 0;       //idle callback that highlights matches, a slice of the text at a time
+  int searchOffset = 0;        //where the next slice begins
+  uint searchFound = 0;
+  bool searchFinished = true;
+  #elif HIRO_GTK==3
+  GtkSourceSearchSettings* gtkSourceSearchSettings = nullptr;
+  GtkSourceSearchContext* gtkSourceSearchContext = nullptr;
+  #endif
 };
 
 }
@@ -76,6 +76,7 @@ auto pTreeViewItem::setIcon(const image& icon) -> void {
     if(icon) {
       auto pixbuf = CreatePixbuf(icon);
       gtk_tree_store_set(parentWidget->gtkTreeStore, &gtkIter, 1, pixbuf, -1);
+      g_object_unref(pixbuf);  //the store holds its own reference
     } else {
       gtk_tree_store_set(parentWidget->gtkTreeStore, &gtkIter, 1, nullptr, -1);
     }
@@ -102,6 +103,10 @@ auto pTreeViewItem::setText(const string& text) -> void {
   _updateWidth();
 }
 
+auto pTreeViewItem::sort(const vector<int>& order) -> void {
+  if(auto parentWidget = _parentWidget()) parentWidget->_reorder(&gtkIter, order);
+}
+
 //
 
 //recursive function to find the minimum (pre-computed / cached) width of a TreeViewItem tree
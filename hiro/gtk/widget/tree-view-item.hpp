@@ -16,6 +16,7 @@ struct pTreeViewItem : pObject {
   auto setIcon(const image& icon) -> void;
   auto setSelected() -> void;
   auto setText(const string& text) -> void;
+  auto sort(const vector<int>& order) -> void;
 
   auto _minimumWidth(uint depth = 0) -> uint;
   auto _parentItem() -> pTreeViewItem*;
@@ -119,6 +119,10 @@ auto pTreeView::setGeometry(Geometry geometry) -> void {
   _updateScrollBars();
 }
 
+auto pTreeView::sort(const vector<int>& order) -> void {
+  _reorder(nullptr, order);
+}
+
 //
 
 auto pTreeView::_activatePath(GtkTreePath* gtkPath) -> void {
@@ -227,6 +231,16 @@ auto pTreeView::_doDataFunc(GtkTreeViewColumn* column, GtkCellRenderer* renderer
   }
 }
 
+//order[n] is the previous position of the row that moves to n
+//rows keep their iterators, and so their expansion and selection: only the path of the selection changes
+auto pTreeView::_reorder(GtkTreeIter* parent, const vector<int>& order) -> void {
+  if(order.size() < 2) return;
+  gtk_tree_store_reorder(gtkTreeStore, parent, (gint*)order.data());
+  lock();
+  _updateSelected();  //the same row remains selected: update its path without signaling a change
+  unlock();
+}
+
 auto pTreeView::_togglePath(string path) -> void {
   if(auto item = self().item(path.transform(":", "/"))) {
     bool checked = !item->checked();
@@ -12,10 +12,12 @@ struct pTreeView : pWidget {
   auto setFocused() -> void override;
   auto setForegroundColor(Color color) -> void;
   auto setGeometry(Geometry geometry) -> void;
+  auto sort(const vector<int>& order) -> void;
 
   auto _activatePath(GtkTreePath* gtkPath) -> void;
   auto _buttonEvent(GdkEventButton* gdkEvent) -> int;
   auto _doDataFunc(GtkTreeViewColumn* column, GtkCellRenderer* renderer, GtkTreeIter* iter) -> void;
+  auto _reorder(GtkTreeIter* parent, const vector<int>& order) -> void;
   auto _togglePath(string path) -> void;
   auto _updateScrollBars() -> void;
   auto _updateSelected() -> void;
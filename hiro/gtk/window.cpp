@@ -51,6 +51,7 @@ static auto Window_expose(GtkWidget* widget, GdkEvent* event, pWindow* p) -> int
 }
 
 static auto Window_configure(GtkWidget* widget, GdkEvent* event, pWindow* p) -> int {
+  p->_synchronizeGeometry();  //the event loop no longer polls geometry, and moves do not reallocate the window
   p->_synchronizeMargin();
   return false;
 }
@@ -78,6 +79,7 @@ static auto Window_getPreferredHeight(GtkWidget* widget, int* minimalHeight, int
 }
 
 static auto Window_keyPress(GtkWidget* widget, GdkEventKey* event, pWindow* p) -> int {
+  pKeyboard::_event(event->hardware_keycode, true);
   if(auto key = pKeyboard::_translate(event->keyval)) {
     p->self().doKeyPress(key);
   }
@@ -93,6 +95,7 @@ static auto Window_keyPress(GtkWidget* widget, GdkEventKey* event, pWindow* p) -
 }
 
 static auto Window_keyRelease(GtkWidget* widget, GdkEventKey* event, pWindow* p) -> int {
+  pKeyboard::_event(event->hardware_keycode, false);
   if(auto key = pKeyboard::_translate(event->keyval)) {
     p->self().doKeyRelease(key);
   }
@@ -393,10 +396,10 @@ auto pWindow::setModal(bool modal) -> void {
     while(!Application::state().quit && state().modal) {
       if(Application::state().onMain) {
         Application::doMain();
+        Application::processEvents();
       } else {
-        usleep(20 * 1000);
+        gtk_main_iteration_do(true);  //sleep until there is an event to handle
       }
-      Application::processEvents();
     }
     gtk_window_set_modal(GTK_WINDOW(widget), false);
   }
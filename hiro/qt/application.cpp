@@ -54,6 +54,10 @@ auto pApplication::setScreenSaver(bool screenSaver) -> void {
   #endif
 }
 
+auto pApplication::watch(int descriptor, const function<void ()>& callback) -> bool {
+  return false;
+}
+
 auto pApplication::state() -> State& {
   static State state;
   return state;
@@ -19,6 +19,10 @@ auto pKeyboard::poll() -> vector<bool> {
   return result;
 }
 
+auto pKeyboard::polled() -> bool {
+  return true;
+}
+
 auto pKeyboard::pressed(unsigned code) -> bool {
   char state[256];
 
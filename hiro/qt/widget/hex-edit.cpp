@@ -36,7 +36,7 @@ auto pHexEdit::destruct() -> void {
   qtScrollBar = nullptr;
 }
 
-auto pHexEdit::setAddress(unsigned address) -> void {
+auto pHexEdit::setAddress(uint64_t address) -> void {
   _setState();
 }
 
@@ -61,7 +61,7 @@ auto pHexEdit::setForegroundColor(Color color) -> void {
   qtHexEdit->setPalette(palette);
 }
 
-auto pHexEdit::setLength(unsigned length) -> void {
+auto pHexEdit::setLength(uint64_t length) -> void {
   _setState();
 }
 
@@ -78,7 +78,7 @@ auto pHexEdit::update() -> void {
   unsigned cursorPosition = qtHexEdit->textCursor().position();
 
   string output;
-  unsigned address = state().address;
+  uint64_t address = state().address;
   for(unsigned row = 0; row < state().rows; row++) {
     output.append(hex(address, 8L));
     output.append("  ");
@@ -210,7 +210,7 @@ auto pHexEdit::_keyPressEvent(QKeyEvent* event) -> void {
       cursorX /= 3;
       if(cursorX < state().columns) {
         //not in ANSI region
-        unsigned address = state().address + (cursorY * state().columns + cursorX);
+        uint64_t address = state().address + (cursorY * state().columns + cursorX);
 
         if(address >= state().length) return;  //do not edit past end of file
         uint8_t data = self().doRead(address);
@@ -292,7 +292,7 @@ auto QtHexEditScrollBar::event(QEvent* event) -> bool {
 
 auto QtHexEditScrollBar::onScroll() -> void {
   if(p.locked()) return;
-  unsigned address = sliderPosition();
+  uint64_t address = sliderPosition();
   p.state().address = address * p.state().columns;
   p.update();
 }
@@ -68,6 +68,10 @@ auto pApplication::quit() -> void {
 auto pApplication::setScreenSaver(bool screenSaver) -> void {
 }
 
+auto pApplication::watch(int descriptor, const function<void ()>& callback) -> bool {
+  return false;
+}
+
 auto pApplication::initialize() -> void {
   CoInitialize(0);
   InitCommonControls();
@@ -10,6 +10,10 @@ auto pKeyboard::poll() -> vector<bool> {
   return result;
 }
 
+auto pKeyboard::polled() -> bool {
+  return true;
+}
+
 auto pKeyboard::pressed(unsigned code) -> bool {
   uint8_t lo = code >> 0;
   uint8_t hi = code >> 8;
@@ -27,7 +27,7 @@ auto pHexEdit::destruct() -> void {
   DestroyWindow(hwnd);
 }
 
-auto pHexEdit::setAddress(unsigned address) -> void {
+auto pHexEdit::setAddress(uint64_t address) -> void {
   SetScrollPos(scrollBar, SB_CTL, address / state().columns, true);
   update();
 }
@@ -44,7 +44,7 @@ auto pHexEdit::setColumns(unsigned columns) -> void {
 auto pHexEdit::setForegroundColor(Color color) -> void {
 }
 
-auto pHexEdit::setLength(unsigned length) -> void {
+auto pHexEdit::setLength(uint64_t length) -> void {
   SetScrollRange(scrollBar, SB_CTL, 0, rowsScrollable(), true);
   EnableWindow(scrollBar, rowsScrollable() > 0);
   update();
@@ -63,7 +63,7 @@ auto pHexEdit::update() -> void {
   unsigned cursorPosition = Edit_GetSel(hwnd);
 
   string output;
-  unsigned address = state().address;
+  uint64_t address = state().address;
   for(auto row : range(state().rows)) {
     output.append(hex(address, 8L));
     output.append("  ");
@@ -150,7 +150,7 @@ auto pHexEdit::keyPress(unsigned scancode) -> bool {
       cursorX /= 3;
       if(cursorX < state().columns) {
         //not in ANSI region
-        unsigned address = state().address + (cursorY * state().columns + cursorX);
+        uint64_t address = state().address + (cursorY * state().columns + cursorX);
 
         if(address >= state().length) return false;  //do not edit past end of data
         uint8_t data = self().doRead(address);
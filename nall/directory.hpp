@@ -26,20 +26,20 @@ struct directory : inode {
   static auto remove(const string& pathname) -> bool;  //recursive
   static auto exists(const string& pathname) -> bool;
 
-  static auto folders(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto folders(const string& pathname, const glob& pattern = "*") -> vector<string> {
     auto folders = directory::ufolders(pathname, pattern);
     folders.sort();
     for(auto& folder : folders) folder.append("/");  //must append after sorting
     return folders;
   }
 
-  static auto files(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto files(const string& pathname, const glob& pattern = "*") -> vector<string> {
     auto files = directory::ufiles(pathname, pattern);
     files.sort();
     return files;
   }
 
-  static auto contents(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto contents(const string& pathname, const glob& pattern = "*") -> vector<string> {
     auto folders = directory::ufolders(pathname);  //pattern search of contents should only filter files
     folders.sort();
     for(auto& folder : folders) folder.append("/");  //must append after sorting
@@ -49,20 +49,20 @@ struct directory : inode {
     return folders;
   }
 
-  static auto ifolders(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto ifolders(const string& pathname, const glob& pattern = "*") -> vector<string> {
     auto folders = ufolders(pathname, pattern);
     folders.isort();
     for(auto& folder : folders) folder.append("/");  //must append after sorting
     return folders;
   }
 
-  static auto ifiles(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto ifiles(const string& pathname, const glob& pattern = "*") -> vector<string> {
     auto files = ufiles(pathname, pattern);
     files.isort();
     return files;
   }
 
-  static auto icontents(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto icontents(const string& pathname, const glob& pattern = "*") -> vector<string> {
     auto folders = directory::ufolders(pathname);  //pattern search of contents should only filter files
     folders.isort();
     for(auto& folder : folders) folder.append("/");  //must append after sorting
@@ -72,10 +72,10 @@ struct directory : inode {
     return folders;
   }
 
-  static auto rcontents(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto rcontents(const string& pathname, const glob& pattern = "*") -> vector<string> {
     vector<string> contents;
-    function<void (const string&, const string&, const string&)>
-    recurse = [&](const string& basename, const string& pathname, const string& pattern) {
+    function<void (const string&, const string&, const glob&)>
+    recurse = [&](const string& basename, const string& pathname, const glob& pattern) {
       for(auto& folder : directory::ufolders(pathname)) {
         contents.append(string{pathname, folder, "/"}.trimLeft(basename, 1L));
         recurse(basename, {pathname, folder, "/"}, pattern);
@@ -95,10 +95,10 @@ struct directory : inode {
     return contents;
   }
 
-  static auto ircontents(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto ircontents(const string& pathname, const glob& pattern = "*") -> vector<string> {
     vector<string> contents;
-    function<void (const string&, const string&, const string&)>
-    recurse = [&](const string& basename, const string& pathname, const string& pattern) {
+    function<void (const string&, const string&, const glob&)>
+    recurse = [&](const string& basename, const string& pathname, const glob& pattern) {
       for(auto& folder : directory::ufolders(pathname)) {
         contents.append(string{pathname, folder, "/"}.trimLeft(basename, 1L));
         recurse(basename, {pathname, folder, "/"}, pattern);
@@ -118,7 +118,7 @@ struct directory : inode {
     return contents;
   }
 
-  static auto rfolders(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto rfolders(const string& pathname, const glob& pattern = "*") -> vector<string> {
     vector<string> folders;
     for(auto& folder : rcontents(pathname, pattern)) {
       if(directory::exists({pathname, folder})) folders.append(folder);
@@ -126,7 +126,7 @@ struct directory : inode {
     return folders;
   }
 
-  static auto irfolders(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto irfolders(const string& pathname, const glob& pattern = "*") -> vector<string> {
     vector<string> folders;
     for(auto& folder : ircontents(pathname, pattern)) {
       if(directory::exists({pathname, folder})) folders.append(folder);
@@ -134,7 +134,7 @@ struct directory : inode {
     return folders;
   }
 
-  static auto rfiles(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto rfiles(const string& pathname, const glob& pattern = "*") -> vector<string> {
     vector<string> files;
     for(auto& file : rcontents(pathname, pattern)) {
       if(file::exists({pathname, file})) files.append(file);
@@ -142,7 +142,7 @@ struct directory : inode {
     return files;
   }
 
-  static auto irfiles(const string& pathname, const string& pattern = "*") -> vector<string> {
+  static auto irfiles(const string& pathname, const glob& pattern = "*") -> vector<string> {
     vector<string> files;
     for(auto& file : ircontents(pathname, pattern)) {
       if(file::exists({pathname, file})) files.append(file);
@@ -150,10 +150,14 @@ struct directory : inode {
     return files;
   }
 
+  //lists pathname one entry at a time, in the order the file system returns them: folders end with "/"
+  //the listing stops early when callback returns false
+  static auto ucontents(const string& pathname, const function<bool (string name)>& callback) -> void;
+
 private:
   //internal functions; these return unsorted lists
-  static auto ufolders(const string& pathname, const string& pattern = "*") -> vector<string>;
-  static auto ufiles(const string& pathname, const string& pattern = "*") -> vector<string>;
+  static auto ufolders(const string& pathname, const glob& pattern = "*") -> vector<string>;
+  static auto ufiles(const string& pathname, const glob& pattern = "*") -> vector<string>;
 };
 
 inline auto directory::copy(const string& source, const string& target) -> bool {
@@ -172,9 +176,9 @@ inline auto directory::copy(const string& source, const string& target) -> bool
 #if defined(PLATFORM_WINDOWS)
   inline auto directory::create(const string& pathname, uint permissions) -> bool {
     string path;
-    auto list = string{pathname}.transform("\\", "/").trimRight("/").split("/");
+    auto trimmed = string{pathname}.transform("\\", "/").trimRight("/");
     bool result = true;
-    for(auto& part : list) {
+    for(auto part : string_split{trimmed, "/"}) {
       path.append(part, "/");
       if(directory::exists(path)) continue;
       result &= (_wmkdir(utf16_t(path)) == 0);
@@ -201,7 +205,7 @@ inline auto directory::copy(const string& source, const string& target) -> bool
     return (result & FILE_ATTRIBUTE_DIRECTORY);
   }
 
-  inline auto directory::ufolders(const string& pathname, const string& pattern) -> vector<string> {
+  inline auto directory::ufolders(const string& pathname, const glob& pattern) -> vector<string> {
     if(!pathname) {
       //special root pseudo-folder (return list of drives)
       wchar_t drives[PATH_MAX] = {0};
@@ -226,14 +230,14 @@ inline auto directory::copy(const string& source, const string& target) -> bool
       if(wcscmp(data.cFileName, L".") && wcscmp(data.cFileName, L"..")) {
         if(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
           string name = (const char*)utf8_t(data.cFileName);
-          if(name.match(pattern)) list.append(name);
+          if(pattern.match(name)) list.append(name);
         }
       }
       while(FindNextFile(handle, &data) != false) {
         if(wcscmp(data.cFileName, L".") && wcscmp(data.cFileName, L"..")) {
           if(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
             string name = (const char*)utf8_t(data.cFileName);
-            if(name.match(pattern)) list.append(name);
+            if(pattern.match(name)) list.append(name);
           }
         }
       }
@@ -242,7 +246,26 @@ inline auto directory::copy(const string& source, const string& target) -> bool
     return list;
   }
 
-  inline auto directory::ufiles(const string& pathname, const string& pattern) -> vector<string> {
+  inline auto directory::ucontents(const string& pathname, const function<bool (string name)>& callback) -> void {
+    if(!pathname) return;
+
+    string path = pathname;
+    path.transform("/", "\\");
+    if(!path.endsWith("\\")) path.append("\\");
+    path.append("*");
+    WIN32_FIND_DATA data;
+    HANDLE handle = FindFirstFile(utf16_t(path), &data);
+    if(handle == INVALID_HANDLE_VALUE) return;
+    do {
+      if(!wcscmp(data.cFileName, L".") || !wcscmp(data.cFileName, L"..")) continue;
+      string name = (const char*)utf8_t(data.cFileName);
+      if(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) name.append("/");
+      if(!callback(std::move(name))) break;
+    } while(FindNextFile(handle, &data) != false);
+    FindClose(handle);
+  }
+
+  inline auto directory::ufiles(const string& pathname, const glob& pattern) -> vector<string> {
     if(!pathname) return {};
 
     vector<string> list;
@@ -256,12 +279,12 @@ inline auto directory::copy(const string& source, const string& target) -> bool
     if(handle != INVALID_HANDLE_VALUE) {
       if((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0) {
         string name = (const char*)utf8_t(data.cFileName);
-        if(name.match(pattern)) list.append(name);
+        if(pattern.match(name)) list.append(name);
       }
       while(FindNextFile(handle, &data) != false) {
         if((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0) {
           string name = (const char*)utf8_t(data.cFileName);
-          if(name.match(pattern)) list.append(name);
+          if(pattern.match(name)) list.append(name);
         }
       }
       FindClose(handle);
@@ -282,9 +305,9 @@ inline auto directory::copy(const string& source, const string& target) -> bool
 
   inline auto directory::create(const string& pathname, uint permissions) -> bool {
     string path;
-    auto list = string{pathname}.trimRight("/").split("/");
+    auto trimmed = string{pathname}.trimRight("/");
     bool result = true;
-    for(auto& part : list) {
+    for(auto part : string_split{trimmed, "/"}) {
       path.append(part, "/");
       if(directory::exists(path)) continue;
       result &= (mkdir(path, permissions) == 0);
@@ -309,7 +332,7 @@ inline auto directory::copy(const string& source, const string& target) -> bool
     return S_ISDIR(data.st_mode);
   }
 
-  inline auto directory::ufolders(const string& pathname, const string& pattern) -> vector<string> {
+  inline auto directory::ufolders(const string& pathname, const glob& pattern) -> vector<string> {
     if(!pathname) return vector<string>{"/"};
 
     vector<string> list;
@@ -322,14 +345,29 @@ inline auto directory::copy(const string& source, const string& target) -> bool
         if(!strcmp(ep->d_name, "..")) continue;
         if(!directoryIsFolder(dp, ep)) continue;
         string name{ep->d_name};
-        if(name.match(pattern)) list.append(std::move(name));
+        if(pattern.match(name)) list.append(std::move(name));
       }
       closedir(dp);
     }
     return list;
   }
 
-  inline auto directory::ufiles(const string& pathname, const string& pattern) -> vector<string> {
+  inline auto directory::ucontents(const string& pathname, const function<bool (string name)>& callback) -> void {
+    if(!pathname) return;
+
+    DIR* dp = opendir(pathname);
+    if(!dp) return;
+    while(auto ep = readdir(dp)) {
+      if(!strcmp(ep->d_name, ".")) continue;
+      if(!strcmp(ep->d_name, "..")) continue;
+      string name{ep->d_name};
+      if(directoryIsFolder(dp, ep)) name.append("/");
+      if(!callback(std::move(name))) break;
+    }
+    closedir(dp);
+  }
+
+  inline auto directory::ufiles(const string& pathname, const glob& pattern) -> vector<string> {
     if(!pathname) return {};
 
     vector<string> list;
@@ -342,7 +380,7 @@ inline auto directory::copy(const string& source, const string& target) -> bool
         if(!strcmp(ep->d_name, "..")) continue;
         if(directoryIsFolder(dp, ep)) continue;
         string name{ep->d_name};
-        if(name.match(pattern)) list.append(std::move(name));
+        if(pattern.match(name)) list.append(std::move(name));
       }
       closedir(dp);
     }
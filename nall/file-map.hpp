@@ -9,6 +9,8 @@
   #include <nall/windows/utf8.hpp>
 #else
   #include <fcntl.h>
+  #include <setjmp.h>
+  #include <signal.h>
   #include <unistd.h>
   #include <sys/mman.h>
   #include <sys/stat.h>
@@ -39,11 +41,51 @@ struct file_map {
   auto data() -> uint8_t* { return _data; }
   auto data() const -> const uint8_t* { return _data; }
 
+  //another program may truncate a mapped file: on POSIX, touching a page past its new end raises SIGBUS,
+  //which would end the process; guard() runs callback, and returns false if it faulted that way instead
+  //callback is abandoned where it faulted: it must not hold a lock while it reads the mapping, and what it had allocated is not freed
+  template<typename F> static auto guard(F&& callback) -> bool {
+    #if defined(API_POSIX)
+    _guardInstall();
+    sigjmp_buf jump;
+    auto previous = _guardJump();
+    if(sigsetjmp(jump, 0)) return _guardJump() = previous, false;
+    _guardJump() = &jump;
+    callback();
+    _guardJump() = previous;
+    #else
+    callback();  //Windows refuses to truncate a file while it is mapped
+    #endif
+    return true;
+  }
+
 //auto operator=(file_map&& source) -> file_map&;
 //auto open(const string& filename, uint mode) -> bool;
+//auto release(uint64_t offset, uint64_t size) -> void;
 //auto close() -> void;
 
 private:
+  #if defined(API_POSIX)
+  static auto _guardJump() -> sigjmp_buf*& {
+    static thread_local sigjmp_buf* jump = nullptr;
+    return jump;
+  }
+
+  static auto _guardInstall() -> void {
+    static bool installed = [] {
+      struct sigaction action{};
+      action.sa_sigaction = [](int signal, siginfo_t*, void*) {
+        if(auto jump = _guardJump()) siglongjmp(*jump, 1);
+        ::signal(signal, SIG_DFL);  //outside of guard(): the access faults again, and ends the process as it would have
+      };
+      action.sa_flags = SA_SIGINFO | SA_NODEFER;
+      sigemptyset(&action.sa_mask);
+      return sigaction(SIGBUS, &action, nullptr) == 0;
+    }();
+    (void)installed;
+  }
+  #endif
+
   bool _open = false;  //zero-byte files return _data = nullptr, _size = 0
   uint8_t* _data = nullptr;
   uint64_t _size = 0;
@@ -75,6 +117,7 @@ public:
     if(file::exists(filename) && file::size(filename) == 0) return _open = true;
 
     int desiredAccess, creationDisposition, protection, mapAccess;
+    int shareMode = FILE_SHARE_READ;
 
     switch(mode_) {
     default: return false;
@@ -83,6 +126,8 @@ public:
       creationDisposition = OPEN_EXISTING;
       protection = PAGE_READONLY;
       mapAccess = FILE_MAP_READ;
+      //let other programs rewrite, rename or delete the file while it is mapped, as they can on POSIX
+      shareMode = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
       break;
     case mode::write:
       //write access requires read access
@@ -105,13 +150,15 @@ public:
       break;
     }
 
-    _file = CreateFileW(utf16_t(filename), desiredAccess, FILE_SHARE_READ, nullptr,
+    _file = CreateFileW(utf16_t(filename), desiredAccess, shareMode, nullptr,
       creationDisposition, FILE_ATTRIBUTE_NORMAL, nullptr);
     if(_file == INVALID_HANDLE_VALUE) return false;
 
-    _size = GetFileSize(_file, nullptr);
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(_file, &size)) size.QuadPart = 0;
+    _size = size.QuadPart;
 
-    _map = CreateFileMapping(_file, nullptr, protection, 0, _size, nullptr);
+    _map = CreateFileMapping(_file, nullptr, protection, _size >> 32, _size & 0xffffffff, nullptr);
     if(_map == INVALID_HANDLE_VALUE) {
       CloseHandle(_file);
       _file = INVALID_HANDLE_VALUE;
@@ -122,6 +169,13 @@ public:
     return _open = true;
   }
 
+  //hint that a range will not be accessed again soon: its pages may leave the working set,
+  //and will be read back from the file if they are touched again
+  auto release(uint64_t offset, uint64_t size) -> void {
+    if(!_data || offset >= _size) return;
+    VirtualUnlock(_data + offset, min(size, _size - offset));
+  }
+
   auto close() -> void {
     if(_data) {
       UnmapViewOfFile(_data);
@@ -205,6 +259,16 @@ public:
     return _open = true;
   }
 
+  //hint that a range will not be accessed again soon: its pages may leave the working set,
+  //and will be read back from the file if they are touched again
+  auto release(uint64_t offset, uint64_t size) -> void {
+    if(!_data || offset >= _size) return;
+    uint64_t page = sysconf(_SC_PAGESIZE);
+    uint64_t lo = offset / page * page;
+    uint64_t hi = min(offset + size, _size);
+    madvise(_data + lo, hi - lo, MADV_DONTNEED);
+  }
+
   auto close() -> void {
     if(_data) {
       munmap(_data, _size);
@@ -0,0 +1,254 @@
+#pragma once
+
+//reports changes to the entries of watched folders: creation, removal, modification and renaming
+//Linux uses inotify; other platforms compare snapshots of each folder, taken at most once per second
+
+#include <nall/chrono.hpp>
+#include <nall/directory.hpp>
+#include <nall/file.hpp>
+#include <nall/hashset.hpp>
+#include <nall/string.hpp>
+#include <nall/vector.hpp>
+
+#if defined(PLATFORM_LINUX)
+  #include <sys/inotify.h>
+  #include <unistd.h>
+#endif
+
+namespace nall {
+
+struct file_watcher {
+  //overflow: events were lost, so every watched folder should be compared with the file system again
+  struct action { enum : uint { create, remove, modify, rename, overflow }; };
+
+  struct event {
+    uint action = 0;
+    string location;  //folders end with "/"; empty for overflow
+    string previous;  //location before a rename
+  };
+
+  file_watcher(const file_watcher&) = delete;
+  auto operator=(const file_watcher&) = delete;
+
+  file_watcher() = default;
+  ~file_watcher() { reset(); }
+
+  //pathname must end with "/"
+  auto watching(const string& pathname) const -> bool {
+    for(auto& folder : _folders) {
+      if(folder.pathname == pathname) return true;
+    }
+    return false;
+  }
+
+//auto descriptor() -> int;
+//auto watch(const string& pathname) -> bool;
+//auto unwatch(const string& pathname) -> void;
+//auto poll() -> vector<event>;
+//auto reset() -> void;
+
+private:
+  #if defined(PLATFORM_LINUX)
+
+  struct folder {
+    string pathname;
+    int descriptor = -1;
+  };
+
+  vector<folder> _folders;
+  int _fd = -1;
+
+  auto _find(int descriptor) -> maybe<folder&> {
+    for(auto& folder : _folders) {
+      if(folder.descriptor == descriptor) return folder;
+    }
+    return nothing;
+  }
+
+public:
+  //becomes readable when poll() has events to return, so that an event loop may wait on it
+  auto descriptor() -> int {
+    if(_fd < 0) _fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    return _fd;
+  }
+
+  auto watch(const string& pathname) -> bool {
+    if(watching(pathname)) return true;
+    if(descriptor() < 0) return false;
+    uint32_t mask = IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB | IN_MOVED_FROM | IN_MOVED_TO;
+    int descriptor = inotify_add_watch(_fd, pathname, mask | IN_ONLYDIR | IN_EXCL_UNLINK);
+    if(descriptor < 0) return false;
+    //watching the same folder through another path returns the existing descriptor
+    if(auto folder = _find(descriptor)) return folder().pathname = pathname, true;
+    _folders.append({pathname, descriptor});
+    return true;
+  }
+
+  //stops watching pathname and every folder beneath it
+  auto unwatch(const string& pathname) -> void {
+    for(uint index = 0; index < _folders.size();) {
+      if(!_folders[index].pathname.beginsWith(pathname)) { index++; continue; }
+      inotify_rm_watch(_fd, _folders[index].descriptor);
+      _folders.remove(index);
+    }
+  }
+
+  //returns the changes since the last call, without blocking
+  auto poll() -> vector<event> {
+    vector<event> events;
+    if(_fd < 0) return events;
+    struct moved { uint32_t cookie; uint index; bool paired; };
+    vector<moved> moves;  //IN_MOVED_FROM events awaiting their IN_MOVED_TO
+    hashset<string> modified;  //a single write may raise several events: report each file once
+    alignas(struct inotify_event) char buffer[16 * 1024];
+    ssize_t size;
+    while((size = read(_fd, buffer, sizeof(buffer))) > 0) {
+      for(char* p = buffer; p < buffer + size;) {
+        auto e = (const struct inotify_event*)p;
+        p += sizeof(struct inotify_event) + e->len;
+        if(e->mask & IN_Q_OVERFLOW) {  //the kernel queue was full: raised with wd == -1
+          events.append({action::overflow});
+          continue;
+        }
+        auto folder = _find(e->wd);
+        if(!folder) continue;
+        if(e->mask & IN_IGNORED) {  //folder was removed, or unwatched
+          _folders.remove(&folder() - _folders.data());
+          continue;
+        }
+        if(!e->len) continue;  //event on the watched folder itself: its parent reports it
+        string location{folder().pathname, (const char*)e->name};
+        if(e->mask & IN_ISDIR) location.append("/");
+
+        if(e->mask & IN_CREATE) events.append({action::create, location});
+        if(e->mask & IN_DELETE) events.append({action::remove, location});
+        if(e->mask & (IN_MODIFY | IN_CLOSE_WRITE | IN_ATTRIB)) {
+          if(!modified.find(location)) modified.insert(location), events.append({action::modify, location});
+        }
+        if(e->mask & IN_MOVED_FROM) {
+          moves.append({e->cookie, (uint)events.size(), false});
+          events.append({action::remove, location});
+        }
+        if(e->mask & IN_MOVED_TO) {
+          maybe<uint> from;
+          for(auto& move : moves) {
+            if(move.cookie == e->cookie) from = move.index, move.paired = true;
+          }
+          if(!from) {
+            events.append({action::create, location});  //moved in from an unwatched folder
+            continue;
+          }
+          auto& event = events[from()];
+          event.action = action::rename;
+          event.previous = event.location;
+          event.location = location;
+          if(location.endsWith("/")) {
+            for(auto& watched : _folders) {
+              if(!watched.pathname.beginsWith(event.previous)) continue;
+              watched.pathname = {location, watched.pathname.slice(event.previous.size())};
+            }
+          }
+        }
+      }
+    }
+    //moved out to an unwatched folder: reported as removed, and its watches would go on reporting the old paths
+    for(auto& move : moves) {
+      if(!move.paired && events[move.index].location.endsWith("/")) unwatch(events[move.index].location);
+    }
+    return events;
+  }
+
+  auto reset() -> void {
+    if(_fd >= 0) ::close(_fd);
+    _fd = -1;
+    _folders.reset();
+  }
+
+  #else
+
+  struct entry {
+    string name;
+    uint64_t timestamp = 0;  //one second resolution on some platforms: size catches more changes
+    uint64_t size = 0;
+  };
+
+  struct folder {
+    string pathname;
+    vector<entry> entries;  //sorted by name
+  };
+
+  vector<folder> _folders;
+  uint64_t _polled = 0;
+
+  static auto _snapshot(const string& pathname) -> vector<entry> {
+    vector<entry> entries;
+    auto names = directory::contents(pathname);
+    names.sort();
+    for(auto& name : names) {
+      string location{pathname, name};
+      entries.append({name, file::timestamp(location, file::time::modify), file::size(location)});
+    }
+    return entries;
+  }
+
+public:
+  //snapshots can only be polled
+  auto descriptor() -> int {
+    return -1;
+  }
+
+  auto watch(const string& pathname) -> bool {
+    if(watching(pathname)) return true;
+    if(!directory::exists(pathname)) return false;
+    _folders.append({pathname, _snapshot(pathname)});
+    return true;
+  }
+
+  //stops watching pathname and every folder beneath it
+  auto unwatch(const string& pathname) -> void {
+    for(uint index = 0; index < _folders.size();) {
+      if(_folders[index].pathname.beginsWith(pathname)) _folders.remove(index);
+      else index++;
+    }
+  }
+
+  //returns the changes since the last snapshot; renames are reported as a removal and a creation
+  auto poll() -> vector<event> {
+    vector<event> events;
+    if(chrono::millisecond() - _polled < 1000) return events;
+    _polled = chrono::millisecond();
+    for(uint index = 0; index < _folders.size();) {
+      auto& folder = _folders[index];
+      if(!directory::exists(folder.pathname)) {
+        _folders.remove(index);  //its parent reports the removal
+        continue;
+      }
+      auto entries = _snapshot(folder.pathname);
+      uint x = 0, y = 0;
+      while(x < folder.entries.size() || y < entries.size()) {
+        int order = x == folder.entries.size() ? 1 : y == entries.size() ? -1 : folder.entries[x].name.compare(entries[y].name);
+        if(order < 0) {
+          events.append({action::remove, {folder.pathname, folder.entries[x++].name}});
+        } else if(order > 0) {
+          events.append({action::create, {folder.pathname, entries[y++].name}});
+        } else {
+          auto& before = folder.entries[x];
+          auto& after = entries[y];
+          if(before.timestamp != after.timestamp || before.size != after.size) events.append({action::modify, {folder.pathname, entries[y].name}});
+          x++, y++;
+        }
+      }
+      folder.entries = move(entries);
+      index++;
+    }
+    return events;
+  }
+
+  auto reset() -> void {
+    _folders.reset();
+  }
+
+  #endif
+};
+
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <nall/file-buffer.hpp>
+#include <nall/location.hpp>
 
 namespace nall {
 
@@ -90,6 +91,117 @@ struct file : inode {
     return false;
   }
 
+  //the file replace() writes: the one a symbolic link refers to, rather than the link
+  static auto target(const string& filename) -> string {
+    #if defined(API_POSIX)
+    char resolved[PATH_MAX];
+    if(realpath(filename, resolved)) return resolved;
+    #endif
+    return filename;
+  }
+
+  //temporary file that replace() writes before renaming it over target(filename)
+  static auto partial(const string& filename) -> string {
+    return _partial(target(filename));
+  }
+
+  //write memory to partial(filename), flush it to disk, then rename it over filename:
+  //should the system fail part way through, filename holds either its previous contents or memory, never a mix
+  //the file keeps its permissions and (where allowed) its owner and group
+  //files with several hard links, and files in folders that cannot be written to, are overwritten in place instead
+  //(on Windows, so are files that another program keeps open)
+  //the same filename must not be replaced by two threads at once, since they would share the temporary file
+  static auto replace(const string& filename, array_view<uint8_t> memory) -> bool {
+    #if defined(API_POSIX)
+    auto target = file::target(filename);
+    auto temporary = _partial(target);
+    struct stat data;
+    bool exists = stat(target, &data) == 0;
+    if(exists && data.st_nlink > 1) return _overwrite(target, memory);  //a rename would detach the other links
+    //O_EXCL | O_NOFOLLOW: never write through a symbolic link planted at the temporary name
+    int flags = O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW | O_CLOEXEC;
+    mode_t mode = exists ? 0600 : 0666;  //new files get the usual 0666 less the umask
+    int fd = ::open(temporary, flags, mode);
+    if(fd < 0 && errno == EEXIST && unlink(temporary) == 0) fd = ::open(temporary, flags, mode);  //left over from a failed save
+    if(fd < 0) return exists ? _overwrite(target, memory) : false;
+    bool success = _write(fd, memory);
+    if(exists) {
+      //changing the owner is only permitted to some users: failing to is not an error
+      if(fchown(fd, data.st_uid, data.st_gid) != 0 && fchown(fd, -1, data.st_gid) != 0) {}
+      if(success && fchmod(fd, data.st_mode & 07777) != 0) success = false;
+    }
+    if(success && fsync(fd) != 0) success = false;
+    if(::close(fd) != 0) success = false;
+    if(success && ::rename(temporary, target) == 0) {
+      //the rename itself is only durable once the folder has been flushed as well
+      int folder = ::open(Location::dir(target), O_RDONLY | O_CLOEXEC);
+      if(folder >= 0) fsync(folder), ::close(folder);
+      return true;
+    }
+    unlink(temporary);
+    return false;
+    #elif defined(API_WINDOWS)
+    auto temporary = _partial(filename);
+    bool exists = file::exists(filename);
+    auto handle = CreateFileW(utf16_t(temporary), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(handle == INVALID_HANDLE_VALUE) return exists ? _overwrite(filename, memory) : false;
+    bool success = _write(handle, memory) && FlushFileBuffers(handle);
+    CloseHandle(handle);
+    if(success) {
+      //ReplaceFileW() keeps the attributes and access control list of the file it replaces
+      if(exists && ReplaceFileW(utf16_t(filename), utf16_t(temporary), nullptr, REPLACEFILE_IGNORE_MERGE_ERRORS, nullptr, nullptr)) return true;
+      if(!exists && MoveFileExW(utf16_t(temporary), utf16_t(filename), MOVEFILE_WRITE_THROUGH)) return true;
+    }
+    DeleteFileW(utf16_t(temporary));
+    //another program may hold the file open without FILE_SHARE_DELETE, which prevents replacing it
+    return success && exists ? _overwrite(filename, memory) : false;
+    #endif
+  }
+
+  static auto _partial(const string& target) -> string {
+    return {Location::dir(target), ".", Location::base(target), ".partial"};
+  }
+
+  #if defined(API_POSIX)
+  static auto _write(int fd, array_view<uint8_t> memory) -> bool {
+    for(uint64_t offset = 0; offset < memory.size();) {
+      auto written = ::write(fd, memory.data() + offset, memory.size() - offset);
+      if(written < 0 && errno == EINTR) continue;
+      if(written <= 0) return false;
+      offset += written;
+    }
+    return true;
+  }
+
+  //truncates and rewrites the file itself: not atomic, but keeps its inode
+  static auto _overwrite(const string& target, array_view<uint8_t> memory) -> bool {
+    int fd = ::open(target, O_WRONLY | O_TRUNC | O_CLOEXEC);
+    if(fd < 0) return false;
+    bool success = _write(fd, memory) && fsync(fd) == 0;
+    if(::close(fd) != 0) success = false;
+    return success;
+  }
+  #elif defined(API_WINDOWS)
+  static auto _write(HANDLE handle, array_view<uint8_t> memory) -> bool {
+    for(uint64_t offset = 0; offset < memory.size();) {
+      DWORD written = 0;
+      DWORD length = memory.size() - offset < (1u << 30) ? memory.size() - offset : 1u << 30;
+      if(!WriteFile(handle, memory.data() + offset, length, &written, nullptr) || !written) return false;
+      offset += written;
+    }
+    return true;
+  }
+
+  //truncates and rewrites the file itself: not atomic, but keeps its attributes and links
+  static auto _overwrite(const string& filename, array_view<uint8_t> memory) -> bool {
+    auto handle = CreateFileW(utf16_t(filename), GENERIC_WRITE, FILE_SHARE_READ, nullptr, TRUNCATE_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if(handle == INVALID_HANDLE_VALUE) return false;
+    bool success = _write(handle, memory) && FlushFileBuffers(handle);
+    CloseHandle(handle);
+    return success;
+  }
+  #endif
+
   //create an empty file (will replace existing files)
   static auto create(const string& filename) -> bool {
     if(auto fp = file::open(filename, mode::write)) return true;
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <nall/algorithm.hpp>
+#include <nall/bit.hpp>
+#include <nall/maybe.hpp>
+#include <nall/range.hpp>
+
 //hashset
 //
 //search: O(1) average; O(n) worst
@@ -53,7 +58,7 @@ struct hashset {
           pool[n] = nullptr;
         }
       }
-      delete pool;
+      delete[] pool;
       pool = nullptr;
     }
     length = 8;
@@ -76,7 +81,7 @@ struct hashset {
       }
     }
 
-    delete pool;
+    delete[] pool;
     pool = copy;
     length = size;
   }
@@ -4,6 +4,7 @@
 
 #include <nall/file-map.hpp>
 #include <nall/interpolation.hpp>
+#include <nall/map.hpp>
 #include <nall/stdint.hpp>
 #include <nall/decode/bmp.hpp>
 #include <nall/decode/png.hpp>
@@ -118,6 +119,7 @@ struct image {
 
 private:
   //core.hpp
+  static auto decoded(const uint8_t* data, uint size) -> const image&;
   auto allocate(uint width, uint height, uint stride) -> uint8_t*;
 
   //scale.hpp
@@ -34,7 +34,9 @@ inline image::image(const void* data_, uint size) {
 inline image::image(const vector<uint8_t>& buffer) : image(buffer.data(), buffer.size()) {
 }
 
-template<uint Size> inline image::image(const uint8_t (&Name)[Size]) : image(Name, Size) {
+//arrays are compiled-in resources: each one is only decoded the first time it is used
+template<uint Size> inline image::image(const uint8_t (&Name)[Size]) {
+  operator=(decoded(Name, Size));
 }
 
 inline image::image() {
@@ -44,6 +46,25 @@ inline image::~image() {
   free();
 }
 
+inline auto image::decoded(const uint8_t* data, uint size) -> const image& {
+  struct resource {
+    const uint8_t* data;
+    uint size;
+    auto operator<(const resource& source) const -> bool {
+      return data != source.data ? data < source.data : size < source.size;
+    }
+    auto operator==(const resource& source) const -> bool {
+      return data == source.data && size == source.size;
+    }
+  };
+  static std::mutex mutex;
+  static map<resource, image> images;  //never erased: references stay valid
+  std::lock_guard<std::mutex> lock(mutex);
+  if(auto cached = images.find({data, size})) return cached();
+  images.insert({data, size}, image{data, size});
+  return images.find({data, size})();
+}
+
 inline auto image::operator=(const image& source) -> image& {
   if(this == &source) return *this;
   free();
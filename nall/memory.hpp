@@ -1,8 +1,16 @@
 #pragma once
 
+#include <string.h>
+#include <type_traits>
+
 #include <nall/algorithm.hpp>
+#include <nall/intrinsics.hpp>
 #include <nall/stdint.hpp>
 
+#if defined(__SSE2__)
+  #include <emmintrin.h>
+#endif
+
 namespace nall::memory {
   template<typename T = uint8_t> auto allocate(uint size) -> T*;
   template<typename T = uint8_t> auto allocate(uint size, const T& value) -> T*;
@@ -41,6 +49,69 @@ namespace nall::memory {
 //memcmp, memcpy, memmove have terrible performance on small block sizes (FreeBSD 10.0-amd64)
 //as this library is used extensively by nall/string, and most strings tend to be small,
 //this library hand-codes these functions instead. surprisingly, it's a substantial speedup
+//larger blocks are passed to the C library, which selects SSE2, AVX2 or "rep movsb" code for the running processor;
+//comparisons are not, as memcmp only returns the sign of the difference: they scan 16 bytes at a time with SSE2
+
+//blocks at least this large are copied, moved and filled by the C library
+constexpr uint _threshold = 32;
+
+inline auto _first(uint mask) -> uint {
+  #if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+  return __builtin_ctz(mask);
+  #else
+  uint index = 0;
+  while(!(mask & 1)) mask >>= 1, index++;
+  return index;
+  #endif
+}
+
+//returns the offset of the first byte that differs, or length if none do
+inline auto _mismatch(const uint8_t* t, const uint8_t* s, uint length) -> uint {
+  uint n = 0;
+  #if defined(__SSE2__)
+  for(; n + 16 <= length; n += 16) {
+    auto x = _mm_loadu_si128((const __m128i*)(t + n));
+    auto y = _mm_loadu_si128((const __m128i*)(s + n));
+    uint mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xffff;
+    if(mask) return n + _first(mask);
+  }
+  #else
+  for(; n + 8 <= length; n += 8) {
+    uint64_t x, y;
+    ::memcpy(&x, t + n, 8);
+    ::memcpy(&y, s + n, 8);
+    if(x != y) break;
+  }
+  #endif
+  while(n < length && t[n] == s[n]) n++;
+  return n;
+}
+
+inline auto _lowercase(uint8_t x) -> uint8_t {
+  return x - 'A' < 26u ? x + 32 : x;
+}
+
+//as _mismatch(), with 'A'-'Z' treated as 'a'-'z'
+inline auto _imismatch(const uint8_t* t, const uint8_t* s, uint length) -> uint {
+  uint n = 0;
+  #if defined(__SSE2__)
+  //adding the bias moves 'A'-'Z' to the lowest 26 signed values, so that a single comparison finds them
+  auto bias = _mm_set1_epi8(char(0x80 - 'A'));
+  auto limit = _mm_set1_epi8(char(0x80 + 26));
+  auto bit = _mm_set1_epi8(0x20);
+  auto lowercase = [&](__m128i x) {
+    return _mm_or_si128(x, _mm_and_si128(_mm_cmplt_epi8(_mm_add_epi8(x, bias), limit), bit));
+  };
+  for(; n + 16 <= length; n += 16) {
+    auto x = lowercase(_mm_loadu_si128((const __m128i*)(t + n)));
+    auto y = lowercase(_mm_loadu_si128((const __m128i*)(s + n)));
+    uint mask = ~_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xffff;
+    if(mask) return n + _first(mask);
+  }
+  #endif
+  while(n < length && _lowercase(t[n]) == _lowercase(s[n])) n++;
+  return n;
+}
 
 template<typename T> auto allocate(uint size) -> T* {
   return (T*)malloc(size * sizeof(T));
@@ -61,14 +132,11 @@ inline auto free(void* target) -> void {
 }
 
 template<typename T> auto compare(const void* target, uint capacity, const void* source, uint size) -> int {
-  auto t = (uint8_t*)target;
-  auto s = (uint8_t*)source;
+  auto t = (const uint8_t*)target;
+  auto s = (const uint8_t*)source;
   auto l = min(capacity, size) * sizeof(T);
-  while(l--) {
-    auto x = *t++;
-    auto y = *s++;
-    if(x != y) return x - y;
-  }
+  auto n = _mismatch(t, s, l);
+  if(n < l) return t[n] - s[n];
   if(capacity == size) return 0;
   return -(capacity < size);
 }
@@ -78,16 +146,11 @@ template<typename T> auto compare(const void* target, const void* source, uint s
 }
 
 template<typename T> auto icompare(const void* target, uint capacity, const void* source, uint size) -> int {
-  auto t = (uint8_t*)target;
-  auto s = (uint8_t*)source;
+  auto t = (const uint8_t*)target;
+  auto s = (const uint8_t*)source;
   auto l = min(capacity, size) * sizeof(T);
-  while(l--) {
-    auto x = *t++;
-    auto y = *s++;
-    if(x - 'A' < 26) x += 32;
-    if(y - 'A' < 26) y += 32;
-    if(x != y) return x - y;
-  }
+  auto n = _imismatch(t, s, l);
+  if(n < l) return _lowercase(t[n]) - _lowercase(s[n]);
   return -(capacity < size);
 }
 
@@ -99,6 +162,7 @@ template<typename T> auto copy(void* target, uint capacity, const void* source,
   auto t = (uint8_t*)target;
   auto s = (uint8_t*)source;
   auto l = min(capacity, size) * sizeof(T);
+  if(l >= _threshold) return (T*)::memcpy(target, source, l);
   while(l--) *t++ = *s++;
   return (T*)target;
 }
@@ -111,6 +175,7 @@ template<typename T> auto move(void* target, uint capacity, const void* source,
   auto t = (uint8_t*)target;
   auto s = (uint8_t*)source;
   auto l = min(capacity, size) * sizeof(T);
+  if(l >= _threshold) return (T*)::memmove(target, source, l);
   if(t < s) {
     while(l--) *t++ = *s++;
   } else {
@@ -126,6 +191,9 @@ template<typename T> auto move(void* target, const void* source, uint size) -> T
 }
 
 template<typename T> auto fill(void* target, uint capacity, const T& value) -> T* {
+  if constexpr(sizeof(T) == 1 && std::is_trivially_copyable<T>::value) {
+    if(capacity >= _threshold) return (T*)::memset(target, *(const uint8_t*)&value, capacity);
+  }
   auto t = (T*)target;
   while(capacity--) *t++ = value;
   return (T*)target;
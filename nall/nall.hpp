@@ -21,6 +21,7 @@
 #include <nall/file.hpp>
 #include <nall/file-buffer.hpp>
 #include <nall/file-map.hpp>
+#include <nall/file-watcher.hpp>
 #include <nall/function.hpp>
 #include <nall/galois-field.hpp>
 #include <nall/hashset.hpp>
@@ -62,6 +63,7 @@
 #include <nall/varint.hpp>
 #include <nall/vector.hpp>
 #include <nall/view.hpp>
+#include <nall/wakeup.hpp>
 #include <nall/arguments.hpp>  //todo: compilation errors when included earlier
 #include <nall/decode/base.hpp>
 #include <nall/decode/base64.hpp>
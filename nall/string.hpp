@@ -13,6 +13,7 @@
 #include <nall/array-view.hpp>
 #include <nall/atoi.hpp>
 #include <nall/function.hpp>
+#include <nall/hashset.hpp>
 #include <nall/intrinsics.hpp>
 #include <nall/memory.hpp>
 #include <nall/primitives.hpp>
@@ -267,6 +268,16 @@ public:
   auto qsplit(string_view key, long limit = LONG_MAX) const -> vector<string>;
   auto iqsplit(string_view key, long limit = LONG_MAX) const -> vector<string>;
 
+  //the views reference this string: splitting a temporary would leave them dangling
+  auto splitView(string_view key, long limit = LONG_MAX) const& -> vector<string_view>;
+  auto isplitView(string_view key, long limit = LONG_MAX) const& -> vector<string_view>;
+  auto qsplitView(string_view key, long limit = LONG_MAX) const& -> vector<string_view>;
+  auto iqsplitView(string_view key, long limit = LONG_MAX) const& -> vector<string_view>;
+  auto splitView(string_view key, long limit = LONG_MAX) const&& -> vector<string_view> = delete;
+  auto isplitView(string_view key, long limit = LONG_MAX) const&& -> vector<string_view> = delete;
+  auto qsplitView(string_view key, long limit = LONG_MAX) const&& -> vector<string_view> = delete;
+  auto iqsplitView(string_view key, long limit = LONG_MAX) const&& -> vector<string_view> = delete;
+
   //trim.hpp
   auto trim(string_view lhs, string_view rhs, long limit = LONG_MAX) -> type&;
   auto trimLeft(string_view lhs, long limit = LONG_MAX) -> type&;
@@ -342,8 +353,10 @@ inline auto operator"" _s(const char* value, std::size_t) -> string { return {va
 #include <nall/string/compare.hpp>
 #include <nall/string/convert.hpp>
 #include <nall/string/core.hpp>
+#include <nall/string/searcher.hpp>
 #include <nall/string/find.hpp>
 #include <nall/string/format.hpp>
+#include <nall/string/glob.hpp>
 #include <nall/string/match.hpp>
 #include <nall/string/replace.hpp>
 #include <nall/string/split.hpp>
@@ -13,6 +13,11 @@ inline auto string::contains(string_view characters) const -> maybe<uint> {
 
 template<bool Insensitive, bool Quoted> inline auto string::_find(int offset, string_view source) const -> maybe<uint> {
   if(source.size() == 0) return nothing;
+  if(!Quoted) {
+    if(offset < 0 || offset >= size()) return nothing;
+    if(auto n = string_searcher{source, Insensitive}.find(data(), size(), offset)) return *n - offset;
+    return nothing;
+  }
   auto p = data();
   for(uint n = offset, quoted = 0; n < size();) {
     if(Quoted) { if(p[n] == '\"') { quoted ^= 1; n++; continue; } if(quoted) { n++; continue; } }
@@ -31,34 +36,22 @@ inline auto string::findFrom(int offset, string_view source) const -> maybe<uint
 inline auto string::ifindFrom(int offset, string_view source) const -> maybe<uint> { return _find<1, 0>(offset, source); }
 
 inline auto string::findNext(int offset, string_view source) const -> maybe<uint> {
-  if(source.size() == 0) return nothing;
-  for(int n = offset + 1; n < size(); n++) {
-    if(memory::compare(data() + n, size() - n, source.data(), source.size()) == 0) return n;
-  }
+  if(auto n = string_searcher{source}.find(data(), size(), max(0, offset + 1))) return *n;
   return nothing;
 }
 
 inline auto string::ifindNext(int offset, string_view source) const -> maybe<uint> {
-  if(source.size() == 0) return nothing;
-  for(int n = offset + 1; n < size(); n++) {
-    if(memory::icompare(data() + n, size() - n, source.data(), source.size()) == 0) return n;
-  }
+  if(auto n = string_searcher{source, true}.find(data(), size(), max(0, offset + 1))) return *n;
   return nothing;
 }
 
 inline auto string::findPrevious(int offset, string_view source) const -> maybe<uint> {
-  if(source.size() == 0) return nothing;
-  for(int n = offset - 1; n >= 0; n--) {
-    if(memory::compare(data() + n, size() - n, source.data(), source.size()) == 0) return n;
-  }
+  if(auto n = string_searcher{source}.findPrevious(data(), size(), max(0, offset))) return *n;
   return nothing;
 }
 
 inline auto string::ifindPrevious(int offset, string_view source) const -> maybe<uint> {
-  if(source.size() == 0) return nothing;
-  for(int n = offset - 1; n >= 0; n--) {
-    if(memory::icompare(data() + n, size() - n, source.data(), source.size()) == 0) return n;
-  }
+  if(auto n = string_searcher{source, true}.findPrevious(data(), size(), max(0, offset))) return *n;
   return nothing;
 }
 
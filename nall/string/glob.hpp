@@ -0,0 +1,247 @@
+#pragma once
+
+//wildcard patterns: '*' matches any run of bytes (including none), and '?' matches any one byte
+//a pattern is compiled once into the literal pieces between its '*'s: the first must begin the name, the last must end it,
+//and the others are found left to right in between, each as early as possible (which never rules out a match)
+//matching is binary-safe: both the pattern and the name may contain null bytes
+
+namespace nall {
+
+struct glob {
+  glob() = default;
+  glob(string_view pattern, bool insensitive = false) { reset(pattern, insensitive); }
+  glob(const string& pattern, bool insensitive = false) { reset(pattern, insensitive); }
+  glob(const char* pattern, bool insensitive = false) { reset(pattern, insensitive); }
+
+  //the searchers point into _pattern, which may be stored within the glob itself: copies and moves re-point them
+  glob(const glob& source) { operator=(source); }
+  glob(glob&& source) { operator=(move(source)); }
+
+  auto operator=(const glob& source) -> glob& {
+    if(this != &source) reset(source._pattern, source._insensitive);
+    return *this;
+  }
+
+  auto operator=(glob&& source) -> glob& {
+    if(this == &source) return *this;
+    _pattern = move(source._pattern);
+    _insensitive = source._insensitive;
+    _pieces = move(source._pieces);
+    _minimum = source._minimum;
+    _point();
+    return *this;
+  }
+
+  auto reset(string_view pattern, bool insensitive = false) -> void {
+    _pattern = string{pattern};
+    _insensitive = insensitive;
+    _pieces.reset();
+    _minimum = 0;
+    auto p = _pattern.data();
+    for(uint offset = 0, size = _pattern.size();;) {
+      Piece piece{offset, 0, false};
+      while(offset < size && p[offset] != '*') piece.wildcard |= p[offset++] == '?';
+      piece.size = offset - piece.offset;
+      bool last = offset >= size;
+      //the pieces between consecutive '*'s are empty, and match anywhere
+      if(piece.size || !_pieces || last) _pieces.append(piece);
+      _minimum += piece.size;
+      if(last) break;
+      offset++;
+    }
+    _point();
+  }
+
+  auto pattern() const -> const string& { return _pattern; }
+  auto insensitive() const -> bool { return _insensitive; }
+
+  //true for patterns without '*' or '?', which only match the pattern itself
+  auto literal() const -> bool { return _pieces.size() == 1 && !_pieces.first().wildcard; }
+
+  auto match(string_view name) const -> bool {
+    auto s = name.data();
+    uint size = name.size();
+    if(size < _minimum) return false;
+    auto& first = _pieces.first();
+    if(_pieces.size() == 1) return size == first.size && _equal(first, s);
+    auto& last = _pieces.last();
+    if(!_equal(first, s) || !_equal(last, s + size - last.size)) return false;
+    uint offset = first.size, end = size - last.size;
+    for(uint index = 1; index + 1 < _pieces.size(); index++) {
+      auto& piece = _pieces[index];
+      auto found = _search(piece, s, offset, end);
+      if(!found) return false;
+      offset = found() + piece.size;
+    }
+    return true;
+  }
+
+  //matches without compiling the pattern, for patterns that are used only once
+  static auto match(string_view name, string_view pattern, bool insensitive = false) -> bool {
+    auto s = name.data(), se = s + name.size();
+    auto p = pattern.data(), pe = p + pattern.size();
+    const char* cp = nullptr;  //name position to retry from, after the last '*'
+    const char* mp = nullptr;  //pattern position just past the last '*'
+    while(s < se) {
+      if(p < pe && *p == '*') {
+        if(++p == pe) return true;
+        mp = p, cp = s + 1;
+      } else if(p < pe && (*p == '?' || _fold(*p, insensitive) == _fold(*s, insensitive))) {
+        p++, s++;
+      } else if(mp) {
+        p = mp, s = cp++;
+      } else {
+        return false;
+      }
+    }
+    while(p < pe && *p == '*') p++;
+    return p == pe;
+  }
+
+private:
+  //a run of the pattern between '*'s
+  struct Piece {
+    uint offset;
+    uint size;
+    bool wildcard;  //contains '?'
+    string_searcher searcher;  //pieces without '?' are found with it
+  };
+
+  auto _point() -> void {
+    for(auto& piece : _pieces) {
+      if(!piece.wildcard) piece.searcher.reset(_pattern.data() + piece.offset, piece.size, _insensitive);
+    }
+  }
+
+  static auto _fold(char c, bool insensitive) -> char {
+    return insensitive && c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c;
+  }
+
+  auto _equal(const Piece& piece, const char* s) const -> bool {
+    auto p = _pattern.data() + piece.offset;
+    if(!piece.wildcard) {
+      if(_insensitive) return memory::icompare(s, p, piece.size) == 0;
+      return memory::compare(s, p, piece.size) == 0;
+    }
+    for(uint n : range(piece.size)) {
+      if(p[n] != '?' && _fold(p[n], _insensitive) != _fold(s[n], _insensitive)) return false;
+    }
+    return true;
+  }
+
+  //first offset in [offset, end - piece.size] where the piece matches
+  auto _search(const Piece& piece, const char* s, uint offset, uint end) const -> maybe<uint> {
+    if(end - offset < piece.size) return nothing;
+    if(!piece.wildcard) {
+      if(auto found = piece.searcher.find(s, end, offset)) return (uint)found();
+      return nothing;
+    }
+    for(; offset + piece.size <= end; offset++) {
+      if(_equal(piece, s + offset)) return offset;
+    }
+    return nothing;
+  }
+
+  string _pattern;
+  bool _insensitive = false;
+  vector<Piece> _pieces;
+  uint _minimum = 0;  //bytes that a name must have to match
+};
+
+//tests a name against many patterns at once, and returns the first pattern (in the order appended) that it matches
+//names, and patterns that are only a literal prefix or suffix around one '*' (such as "*.cpp"), are found by hashing;
+//only the other patterns are tried one at a time
+struct glob_set {
+  glob_set(bool insensitive = false) : _insensitive(insensitive) {}
+
+  auto reset() -> void {
+    _globs.reset();
+    _names.reset();
+    _prefixes.reset();
+    _suffixes.reset();
+    _prefixSizes.reset();
+    _suffixSizes.reset();
+    _others.reset();
+  }
+
+  auto size() const -> uint { return _globs.size(); }
+  auto operator[](uint index) const -> const glob& { return _globs[index]; }
+
+  //returns the index of the pattern
+  auto append(string_view pattern) -> uint {
+    uint index = _globs.size();
+    _globs.append(glob{pattern, _insensitive});
+    auto& source = _globs.last().pattern();
+    auto star = source.find("*");
+    bool wildcard = (bool)source.find("?");
+    if(!star && !wildcard) {
+      _insert(_names, {_key(source), index});
+    } else if(!wildcard && star() == 0 && !source.findNext(0, "*")) {
+      _insert(_suffixes, {_key(source.slice(1)), index});
+      _insert(_suffixSizes, source.size() - 1);
+    } else if(!wildcard && star() == source.size() - 1) {
+      _insert(_prefixes, {_key(source.slice(0, star())), index});
+      _insert(_prefixSizes, star());
+    } else {
+      _others.append(index);
+    }
+    return index;
+  }
+
+  auto find(string_view name) -> maybe<uint> {
+    maybe<uint> result;
+    auto consider = [&](maybe<Entry&> entry) {
+      if(entry && (!result || entry->index < result())) result = entry->index;
+    };
+    string key = _key(name);
+    consider(_names.find({key}));
+    for(uint size : _suffixSizes) {
+      if(size <= key.size()) consider(_suffixes.find({key.slice(key.size() - size)}));
+    }
+    for(uint size : _prefixSizes) {
+      if(size <= key.size()) consider(_prefixes.find({key.slice(0, size)}));
+    }
+    for(uint index : _others) {
+      if(result && index > result()) break;  //_others is in order: no later pattern can take precedence
+      if(_globs[index].match(name)) return index;
+    }
+    return result;
+  }
+
+  auto match(string_view name) -> bool { return (bool)find(name); }
+
+private:
+  struct Entry {
+    string key;
+    uint index = 0;
+    auto hash() const -> uint { return key.hash(); }
+    auto operator==(const Entry& source) const -> bool { return key == source.key; }
+  };
+
+  auto _key(string_view text) const -> string {
+    string key{text};
+    if(_insensitive) key.downcase();
+    return key;
+  }
+
+  //a pattern that appears twice keeps its first index
+  static auto _insert(hashset<Entry>& entries, const Entry& entry) -> void {
+    if(!entries.find(entry)) entries.insert(entry);
+  }
+
+  static auto _insert(vector<uint>& sizes, uint size) -> void {
+    for(uint n : sizes) if(n == size) return;
+    sizes.append(size);
+  }
+
+  bool _insensitive = false;
+  vector<glob> _globs;
+  hashset<Entry> _names;
+  hashset<Entry> _prefixes;
+  hashset<Entry> _suffixes;
+  vector<uint> _prefixSizes;  //distinct sizes of the keys in _prefixes
+  vector<uint> _suffixSizes;
+  vector<uint> _others;       //indices of the patterns that must be tried one at a time
+};
+
+}
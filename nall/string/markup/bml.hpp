@@ -36,7 +36,7 @@ protected:
     uint length = 0;
     while(valid(p[length])) length++;
     if(length == 0) throw "Invalid node name";
-    _name = slice(p, 0, length);
+    _name = slice({p, length}, 0, length);
     p += length;
   }
 
@@ -45,18 +45,18 @@ protected:
       uint length = 2;
       while(p[length] && p[length] != '\n' && p[length] != '\"') length++;
       if(p[length] != '\"') throw "Unescaped value";
-      _value = {slice(p, 2, length - 2), "\n"};
+      _value = {slice({p, length}, 2, length - 2), "\n"};
       p += length + 1;
     } else if(*p == '=') {
       uint length = 1;
       while(p[length] && p[length] != '\n' && p[length] != '\"' && p[length] != ' ') length++;
       if(p[length] == '\"') throw "Illegal character in value";
-      _value = {slice(p, 1, length - 1), "\n"};
+      _value = {slice({p, length}, 1, length - 1), "\n"};
       p += length;
     } else if(*p == ':') {
       uint length = 1;
       while(p[length] && p[length] != '\n') length++;
-      _value = {slice(p, 1, length - 1).trimLeft(spacing, 1L), "\n"};
+      _value = {slice({p, length}, 1, length - 1).trimLeft(spacing, 1L), "\n"};
       p += length;
     }
   }
@@ -72,7 +72,7 @@ protected:
       uint length = 0;
       while(valid(p[length])) length++;
       if(length == 0) throw "Invalid attribute name";
-      node->_name = slice(p, 0, length);
+      node->_name = slice({p, length}, 0, length);
       node->parseData(p += length, spacing);
       node->_value.trimRight("\n", 1L);
       _children.append(node);
@@ -80,7 +80,9 @@ protected:
   }
 
   //read a node and all of its child nodes
-  auto parseNode(const vector<string>& text, uint& y, string_view spacing) -> void {
+  //lines are views of the document: every scan stops at the '\n' (or '\0') that follows them,
+  //and slices are bounded, as a string_view of a bare pointer would measure the rest of the document
+  auto parseNode(const vector<string_view>& text, uint& y, string_view spacing) -> void {
     const char* p = text[y++];
     _metadata = parseDepth(p);
     parseName(p);
@@ -130,7 +132,7 @@ protected:
     document.resize(document.size() - (p - output)).trimRight("\n");
     if(document.size() == 0) return;  //empty document
 
-    auto text = document.split("\n");
+    auto text = document.splitView("\n");
     uint y = 0;
     while(y < text.size()) {
       SharedNode node(new ManagedNode);
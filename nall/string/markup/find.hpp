@@ -55,8 +55,10 @@ inline auto ManagedNode::_evaluate(string query) const -> bool {
 inline auto ManagedNode::_find(const string& query) const -> vector<Node> {
   vector<Node> result;
 
-  auto path = query.split("/");
-  string name = path.take(0), rule;
+  auto path = query.splitView("/", 1L);
+  string name{path[0]}, rule;
+  bool leaf = path.size() == 1;
+  string next = leaf ? string{} : string{path[1]};
   uint lo = 0u, hi = ~0u;
 
   if(name.match("*[*]")) {
@@ -78,17 +80,18 @@ inline auto ManagedNode::_find(const string& query) const -> vector<Node> {
   }
 
   uint position = 0;
+  glob pattern{name};  //compiled once for all children
   for(auto& node : _children) {
-    if(!node->_name.match(name)) continue;
+    if(!pattern.match(node->_name)) continue;
     if(!node->_evaluate(rule)) continue;
 
     bool inrange = position >= lo && position <= hi;
     position++;
     if(!inrange) continue;
 
-    if(path.size() == 0) {
+    if(leaf) {
       result.append(node);
-    } else for(auto& item : node->_find(path.merge("/"))) {
+    } else for(auto& item : node->_find(next)) {
       result.append(item);
     }
   }
@@ -116,6 +119,22 @@ inline auto ManagedNode::_lookup(const string& path) const -> Node {
 */
 }
 
+//operator[](Key)
+inline auto ManagedNode::_lookup(const Key& key) const -> Node {
+  if(!key.names) return {};
+  const ManagedNode* node = this;
+  SharedNode found;
+  for(auto& name : key.names) {
+    found = {};
+    for(auto& child : node->_children) {
+      if(child->_name == name) { found = child; break; }
+    }
+    if(!found) return {};
+    node = found.data();
+  }
+  return found;
+}
+
 inline auto ManagedNode::_create(const string& path) -> Node {
   if(auto position = path.find("/")) {
     auto name = slice(path, 0, *position);
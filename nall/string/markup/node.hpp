@@ -6,6 +6,15 @@ struct Node;
 struct ManagedNode;
 using SharedNode = shared_pointer<ManagedNode>;
 
+//a path split into its names once, for lookups that are repeated many times
+//unlike operator[](string), names are matched exactly: there are no patterns, ranges or rules
+struct Key {
+  Key() = default;
+  explicit Key(const nall::string& path) : names(path.split("/")) {}
+
+  vector<nall::string> names;
+};
+
 struct ManagedNode {
   ManagedNode() = default;
   ManagedNode(const string& name) : _name(name) {}
@@ -38,6 +47,7 @@ protected:
   auto _evaluate(string query) const -> bool;
   auto _find(const string& query) const -> vector<Node>;
   auto _lookup(const string& path) const -> Node;
+  auto _lookup(const Key& key) const -> Node;
   auto _create(const string& path) -> Node;
 
   friend class Node;
@@ -123,6 +133,7 @@ struct Node {
   }
 
   auto operator[](const nall::string& path) const -> Node { return shared->_lookup(path); }
+  auto operator[](const Key& key) const -> Node { return shared->_lookup(key); }
   auto operator()(const nall::string& path) -> Node { return shared->_create(path); }
   auto find(const nall::string& query) const -> vector<Node> { return shared->_find(query); }
 
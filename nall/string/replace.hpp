@@ -9,13 +9,20 @@ inline auto string::_replace(string_view from, string_view to, long limit) -> st
   int size = this->size();
   int matches = 0;
   int quoted = 0;
+  string_searcher searcher{from, Insensitive};
 
   //count matches first, so that we only need to reallocate memory once
   //(recording matches would also require memory allocation, so this is not done)
   { const char* p = data();
     for(int n = 0; n <= size - (int)from.size();) {
-      if(Quoted) { if(p[n] == '\"') { quoted ^= 1; n++; continue; } if(quoted) { n++; continue; } }
-      if(_compare<Insensitive>(p + n, size - n, from.data(), from.size())) { n++; continue; }
+      if(Quoted) {
+        if(p[n] == '\"') { quoted ^= 1; n++; continue; } if(quoted) { n++; continue; }
+        if(_compare<Insensitive>(p + n, size - n, from.data(), from.size())) { n++; continue; }
+      } else {
+        auto next = searcher.find(p, size, n);
+        if(!next) break;
+        n = next();
+      }
 
       if(++matches >= limit) break;
       n += from.size();
@@ -28,8 +35,14 @@ inline auto string::_replace(string_view from, string_view to, long limit) -> st
     char* p = get();
 
     for(int n = 0, remaining = matches, quoted = 0; n <= size - (int)from.size();) {
-      if(Quoted) { if(p[n] == '\"') { quoted ^= 1; n++; continue; } if(quoted) { n++; continue; } }
-      if(_compare<Insensitive>(p + n, size - n, from.data(), from.size())) { n++; continue; }
+      if(Quoted) {
+        if(p[n] == '\"') { quoted ^= 1; n++; continue; } if(quoted) { n++; continue; }
+        if(_compare<Insensitive>(p + n, size - n, from.data(), from.size())) { n++; continue; }
+      } else {
+        auto next = searcher.find(p, size, n);
+        if(!next) break;
+        n = next();
+      }
 
       memory::copy(p + n, to.data(), to.size());
 
@@ -45,8 +58,14 @@ inline auto string::_replace(string_view from, string_view to, long limit) -> st
     int base = 0;
 
     for(int n = 0, remaining = matches, quoted = 0; n <= size - (int)from.size();) {
-      if(Quoted) { if(p[n] == '\"') { quoted ^= 1; n++; continue; } if(quoted) { n++; continue; } }
-      if(_compare<Insensitive>(p + n, size - n, from.data(), from.size())) { n++; continue; }
+      if(Quoted) {
+        if(p[n] == '\"') { quoted ^= 1; n++; continue; } if(quoted) { n++; continue; }
+        if(_compare<Insensitive>(p + n, size - n, from.data(), from.size())) { n++; continue; }
+      } else {
+        auto next = searcher.find(p, size, n);
+        if(!next) break;
+        n = next();
+      }
 
       if(base) memory::move(p + offset, p + base, n - base);
       memory::copy(p + offset + (n - base), to.data(), to.size());
@@ -70,8 +89,14 @@ inline auto string::_replace(string_view from, string_view to, long limit) -> st
     int base = size;
 
     for(int n = size, remaining = matches; n >= (int)from.size();) {  //quoted reused from parent scope since we are iterating backward
-      if(Quoted) { if(p[n] == '\"') { quoted ^= 1; n--; continue; } if(quoted) { n--; continue; } }
-      if(_compare<Insensitive>(p + n - from.size(), size - n + from.size(), from.data(), from.size())) { n--; continue; }
+      if(Quoted) {
+        if(p[n] == '\"') { quoted ^= 1; n--; continue; } if(quoted) { n--; continue; }
+        if(_compare<Insensitive>(p + n - from.size(), size - n + from.size(), from.data(), from.size())) { n--; continue; }
+      } else {
+        auto previous = searcher.findPrevious(p, size, n - from.size() + 1);
+        if(!previous) break;
+        n = previous() + from.size();
+      }
 
       memory::move(p + offset - (base - n), p + base - (base - n), base - n);
       memory::copy(p + offset - (base - n) - to.size(), to.data(), to.size());
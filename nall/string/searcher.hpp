@@ -0,0 +1,228 @@
+#pragma once
+
+//finds a needle within a block of memory, forward or in reverse, optionally folding 'A'-'Z' to 'a'-'z'
+//candidates are found by testing the first and last bytes of the needle against 16 positions at once (SSE2);
+//should verifying them cost too much (repetitive text, such as "aaab" within "aaaa..."),
+//the search continues with the two-way algorithm, which compares each byte of the haystack a bounded number of times
+//the needle is referenced, not copied: it must outlive the searcher
+
+namespace nall {
+
+struct string_searcher {
+  string_searcher() { reset(nullptr, 0); }
+  string_searcher(const string_view& needle, bool insensitive = false) { reset(needle, insensitive); }
+  string_searcher(const string& needle, bool insensitive = false) { reset(needle, insensitive); }
+
+  //string_view copies made from non-const lvalues own a temporary string: bind to the originals instead
+  auto reset(const string_view& needle, bool insensitive = false) -> void { reset(needle.data(), needle.size(), insensitive); }
+  auto reset(const string& needle, bool insensitive = false) -> void { reset(needle.data(), needle.size(), insensitive); }
+
+  auto reset(const char* needle, uint size, bool insensitive = false) -> void {
+    _needle = (const uint8_t*)needle;
+    _size = size;
+    _insensitive = insensitive;
+    if(_insensitive) {
+      _forward = _factorize<0, 1>();
+      _reverse = _factorize<1, 1>();
+    } else {
+      _forward = _factorize<0, 0>();
+      _reverse = _factorize<1, 0>();
+    }
+  }
+
+  auto size() const -> uint { return _size; }
+
+  //first match that starts at or after from
+  auto find(const void* data, uint64_t size, uint64_t from = 0) const -> maybe<uint64_t> {
+    if(_insensitive) return _search<0, 1>((const uint8_t*)data, size, from);
+    return _search<0, 0>((const uint8_t*)data, size, from);
+  }
+
+  //last match that starts before before
+  auto findPrevious(const void* data, uint64_t size, uint64_t before) const -> maybe<uint64_t> {
+    if(_insensitive) return _search<1, 1>((const uint8_t*)data, size, before);
+    return _search<1, 0>((const uint8_t*)data, size, before);
+  }
+
+private:
+  //the critical factorization of the needle, as read in one direction
+  struct Factorization {
+    int64_t critical = -1;  //the left half ends here (inclusive)
+    uint64_t period = 1;
+    uint64_t memory = 0;    //for periodic needles, the length of the prefix that is known to match after a shift
+  };
+
+  template<bool Insensitive> static auto _fold(uint8_t x) -> uint8_t {
+    if(Insensitive && x - 'A' < 26u) return x + 32;
+    return x;
+  }
+
+  //byte index of the needle, as read in the given direction
+  template<bool Reverse, bool Insensitive> auto _at(uint64_t index) const -> uint8_t {
+    return _fold<Insensitive>(_needle[Reverse ? _size - 1 - index : index]);
+  }
+
+  //maximal suffix for either ordering of the alphabet: the one beginning later gives the critical factorization
+  template<bool Reverse, bool Insensitive> auto _factorize() const -> Factorization {
+    Factorization result;
+    if(!_size) return result;
+    auto suffix = [&](bool greater, uint64_t& period) -> int64_t {
+      int64_t i = -1;
+      uint64_t j = 0, k = 1;
+      period = 1;
+      while(j + k < _size) {
+        auto x = _at<Reverse, Insensitive>(i + k);
+        auto y = _at<Reverse, Insensitive>(j + k);
+        if(x == y) {
+          if(k == period) j += period, k = 1;
+          else k++;
+        } else if(greater ? x > y : x < y) {
+          j += k, k = 1;
+          period = j - i;
+        } else {
+          i = j++;
+          k = period = 1;
+        }
+      }
+      return i;
+    };
+    uint64_t lesserPeriod, greaterPeriod;
+    auto lesser = suffix(false, lesserPeriod);
+    auto greater = suffix(true, greaterPeriod);
+    result.critical = lesser > greater ? lesser : greater;
+    result.period = lesser > greater ? lesserPeriod : greaterPeriod;
+
+    bool periodic = result.period < _size;
+    for(int64_t n = 0; periodic && n <= result.critical; n++) {
+      if(_at<Reverse, Insensitive>(n) != _at<Reverse, Insensitive>(n + result.period)) periodic = false;
+    }
+    if(periodic) {
+      result.memory = _size - result.period;
+    } else {
+      result.period = max((uint64_t)result.critical + 1, _size - result.critical - 1) + 1;
+    }
+    return result;
+  }
+
+  template<bool Insensitive> auto _matches(const uint8_t* data) const -> bool {
+    if(Insensitive) return memory::icompare(data, _needle, _size) == 0;
+    return memory::compare(data, _needle, _size) == 0;
+  }
+
+  //Reverse searches from before - 1 down to 0; otherwise from from up to the last position the needle fits
+  template<bool Reverse, bool Insensitive> auto _search(const uint8_t* data, uint64_t size, uint64_t from) const -> maybe<uint64_t> {
+    if(!_size || _size > size) return nothing;
+    uint64_t positions = size - _size + 1;  //starting positions where the needle fits
+    if(Reverse) from = min(from, positions);
+    else if(from >= positions) return nothing;
+
+    uint8_t first = _fold<Insensitive>(_needle[0]);
+    uint8_t last = _fold<Insensitive>(_needle[_size - 1]);
+    auto candidate = [&](uint64_t offset) {
+      return _fold<Insensitive>(data[offset]) == first && _fold<Insensitive>(data[offset + _size - 1]) == last;
+    };
+    uint64_t work = 0;  //bytes verified, beyond the first and last of each candidate
+    auto exceeded = [&](uint64_t scanned) { return work > 1024 + 2 * scanned; };
+
+    #if defined(__SSE2__)
+    auto lower = [](uint8_t x) { return _mm_set1_epi8(char(x)); };
+    auto upper = [](uint8_t x) { return _mm_set1_epi8(char(x - 'a' < 26u ? x - 32 : x)); };
+    auto firstLower = lower(first), firstUpper = Insensitive ? upper(first) : lower(first);
+    auto lastLower = lower(last), lastUpper = Insensitive ? upper(last) : lower(last);
+    //bit n is set where position offset + n may begin a match
+    auto block = [&](uint64_t offset) -> uint {
+      auto x = _mm_loadu_si128((const __m128i*)(data + offset));
+      auto y = _mm_loadu_si128((const __m128i*)(data + offset + _size - 1));
+      auto a = _mm_or_si128(_mm_cmpeq_epi8(x, firstLower), _mm_cmpeq_epi8(x, firstUpper));
+      auto b = _mm_or_si128(_mm_cmpeq_epi8(y, lastLower), _mm_cmpeq_epi8(y, lastUpper));
+      return _mm_movemask_epi8(_mm_and_si128(a, b));
+    };
+    #endif
+
+    if(!Reverse) {
+      uint64_t offset = from;
+      #if defined(__SSE2__)
+      for(; offset + 16 <= positions; offset += 16) {
+        for(uint mask = block(offset); mask; mask &= mask - 1) {
+          auto position = offset + memory::_first(mask);
+          if(_matches<Insensitive>(data + position)) return position;
+          work += _size;
+        }
+        if(exceeded(offset - from)) return _twoWay<0, Insensitive>(data, size, offset + 16);
+      }
+      #endif
+      for(; offset < positions; offset++) {
+        if(!candidate(offset)) continue;
+        if(_matches<Insensitive>(data + offset)) return offset;
+        work += _size;
+        if(exceeded(offset - from)) return _twoWay<0, Insensitive>(data, size, offset + 1);
+      }
+      return nothing;
+    }
+
+    uint64_t offset = from;  //positions below offset remain to be searched
+    #if defined(__SSE2__)
+    for(; offset >= 16; offset -= 16) {
+      for(uint mask = block(offset - 16); mask; mask &= ~(1u << _last(mask))) {
+        auto position = offset - 16 + _last(mask);
+        if(_matches<Insensitive>(data + position)) return position;
+        work += _size;
+      }
+      if(exceeded(from - offset)) return _twoWay<1, Insensitive>(data, size, offset - 16);
+    }
+    #endif
+    while(offset--) {
+      if(!candidate(offset)) continue;
+      if(_matches<Insensitive>(data + offset)) return offset;
+      work += _size;
+      if(exceeded(from - offset)) return _twoWay<1, Insensitive>(data, size, offset);
+    }
+    return nothing;
+  }
+
+  static auto _last(uint mask) -> uint {
+    #if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+    return 31 - __builtin_clz(mask);
+    #else
+    uint index = 0;
+    while(mask >>= 1) index++;
+    return index;
+    #endif
+  }
+
+  //forward: first match starting at or after from; reverse: last match starting before from
+  //the reverse search runs the same algorithm over the reversed haystack and needle
+  template<bool Reverse, bool Insensitive> auto _twoWay(const uint8_t* data, uint64_t size, uint64_t from) const -> maybe<uint64_t> {
+    auto& factorization = Reverse ? _reverse : _forward;
+    int64_t critical = factorization.critical;
+    uint64_t end = Reverse ? min(size, from + _size - 1) : size;  //the reversed haystack is data[0, end)
+    uint64_t length = Reverse ? end : size - from;
+    auto haystack = [&](uint64_t index) -> uint8_t {
+      return _fold<Insensitive>(data[Reverse ? end - 1 - index : from + index]);
+    };
+    uint64_t memory = 0;
+    for(uint64_t position = 0; position + _size <= length;) {
+      uint64_t k = max<uint64_t>(critical + 1, memory);
+      while(k < _size && _at<Reverse, Insensitive>(k) == haystack(position + k)) k++;
+      if(k < _size) {
+        position += k - critical;
+        memory = 0;
+        continue;
+      }
+      k = critical + 1;
+      while(k > memory && _at<Reverse, Insensitive>(k - 1) == haystack(position + k - 1)) k--;
+      if(k <= memory) return Reverse ? end - position - _size : from + position;
+      position += factorization.period;
+      memory = factorization.memory;
+    }
+    return nothing;
+  }
+
+  const uint8_t* _needle = nullptr;
+  uint _size = 0;
+  bool _insensitive = false;
+  Factorization _forward;
+  Factorization _reverse;
+};
+
+}
@@ -11,6 +11,7 @@ inline auto vector<string>::_split(string_view source, string_view find, long li
   int size = source.size();
   int base = 0;
   int matches = 0;
+  string_searcher searcher{find, Insensitive};
 
   for(int n = 0, quoted = 0; n <= size - (int)find.size();) {
     if constexpr(Quoted) {
@@ -18,8 +19,12 @@ inline auto vector<string>::_split(string_view source, string_view find, long li
       if(p[n] == '\'' && quoted != 2) { quoted ^= 1; n++; continue; }
       if(p[n] == '\"' && quoted != 1) { quoted ^= 2; n++; continue; }
       if(quoted) { n++; continue; }
+      if(string::_compare<Insensitive>(p + n, size - n, find.data(), find.size())) { n++; continue; }
+    } else {
+      auto next = searcher.find(p, size, n);
+      if(!next) break;
+      n = next();
     }
-    if(string::_compare<Insensitive>(p + n, size - n, find.data(), find.size())) { n++; continue; }
     if(matches >= limit) break;
 
     string& s = operator()(matches);
@@ -38,9 +43,108 @@ inline auto vector<string>::_split(string_view source, string_view find, long li
   return *this;
 }
 
+//splits lazily: each field is found only when it is asked for, and is returned as a view of the source
+//the fields are the same as those of string::split() (or isplit(), qsplit(), iqsplit()) with the same key and limit
+//the source is referenced, not copied: it must outlive the split and the views it returns; the key is copied
+struct string_split {
+  struct iterator {
+    iterator(string_split* self) : _self(self) { if(_self) _field = _self->next(); }
+    auto operator*() const -> string_view { return _field(); }
+    auto operator!=(const iterator& source) const -> bool { return (bool)_field != (bool)source._field; }
+    auto operator++() -> iterator& { _field = _self->next(); return *this; }
+
+  private:
+    string_split* _self;
+    maybe<string_view> _field;
+  };
+
+  //string_view copies made from non-const lvalues own a temporary string: bind to the originals instead
+  string_split(const string_view& source, string_view key, long limit = LONG_MAX, bool insensitive = false, bool quoted = false) {
+    reset(source.data(), source.size(), key, limit, insensitive, quoted);
+  }
+  string_split(const string& source, string_view key, long limit = LONG_MAX, bool insensitive = false, bool quoted = false) {
+    reset(source.data(), source.size(), key, limit, insensitive, quoted);
+  }
+  string_split(string&& source, string_view key, long limit = LONG_MAX, bool insensitive = false, bool quoted = false) = delete;
+
+  //the searcher references _key
+  string_split(const string_split&) = delete;
+  auto operator=(const string_split&) -> string_split& = delete;
+
+  auto reset(const char* source, uint size, string_view key, long limit = LONG_MAX, bool insensitive = false, bool quoted = false) -> void {
+    _source = source;
+    _size = size;
+    _key = key;
+    _limit = limit;
+    _insensitive = insensitive;
+    _quoted = quoted;
+    _searcher.reset(_key, _insensitive);
+    _offset = _base = _matches = _state = 0;
+    _done = limit <= 0 || !_key;
+  }
+
+  auto next() -> maybe<string_view> {
+    if(_done) return nothing;
+    const char* p = _source;
+    int size = _size;
+    int keySize = _key.size();
+    for(int n = _offset; _matches < _limit && n <= size - keySize;) {
+      if(_quoted) {
+        if(_state && p[n] == '\\') { n += 2; continue; }
+        if(p[n] == '\'' && _state != 2) { _state ^= 1; n++; continue; }
+        if(p[n] == '\"' && _state != 1) { _state ^= 2; n++; continue; }
+        if(_state) { n++; continue; }
+        bool different = _insensitive
+        ? string::_compare<1>(p + n, size - n, _key.data(), keySize)
+        : string::_compare<0>(p + n, size - n, _key.data(), keySize);
+        if(different) { n++; continue; }
+      } else {
+        auto found = _searcher.find(p, size, n);
+        if(!found) break;
+        n = found();
+      }
+      string_view field{p + _base, uint(n - _base)};
+      _offset = _base = n + keySize;
+      _matches++;
+      return field;
+    }
+    _done = true;
+    return string_view{p + _base, uint(size - _base)};
+  }
+
+  auto begin() -> iterator { return {this}; }
+  auto end() -> iterator { return {nullptr}; }
+
+  //the remaining fields
+  auto views() -> vector<string_view> {
+    vector<string_view> fields;
+    while(auto field = next()) fields.append(field());
+    return fields;
+  }
+
+private:
+  const char* _source = nullptr;
+  uint _size = 0;
+  string _key;
+  long _limit = 0;
+  bool _insensitive = false;
+  bool _quoted = false;
+  string_searcher _searcher;
+  int _offset = 0;   //where the search for the next key resumes
+  int _base = 0;     //where the next field begins
+  long _matches = 0;
+  int _state = 0;    //quoted mode: 1 within '', 2 within ""
+  bool _done = false;
+};
+
 inline auto string::split(string_view on, long limit) const -> vector<string> { return vector<string>()._split<0, 0>(*this, on, limit); }
 inline auto string::isplit(string_view on, long limit) const -> vector<string> { return vector<string>()._split<1, 0>(*this, on, limit); }
 inline auto string::qsplit(string_view on, long limit) const -> vector<string> { return vector<string>()._split<0, 1>(*this, on, limit); }
 inline auto string::iqsplit(string_view on, long limit) const -> vector<string> { return vector<string>()._split<1, 1>(*this, on, limit); }
 
+inline auto string::splitView(string_view on, long limit) const& -> vector<string_view> { return string_split{*this, on, limit, 0, 0}.views(); }
+inline auto string::isplitView(string_view on, long limit) const& -> vector<string_view> { return string_split{*this, on, limit, 1, 0}.views(); }
+inline auto string::qsplitView(string_view on, long limit) const& -> vector<string_view> { return string_split{*this, on, limit, 0, 1}.views(); }
+inline auto string::iqsplitView(string_view on, long limit) const& -> vector<string_view> { return string_split{*this, on, limit, 1, 1}.views(); }
+
 }
@@ -1,25 +1,158 @@
 #pragma once
 
+namespace nall::UTF8 {
+
+inline auto _count(uint mask) -> uint {
+  #if defined(COMPILER_CLANG) || defined(COMPILER_GCC)
+  return __builtin_popcount(mask);
+  #else
+  uint count = 0;
+  while(mask) mask &= mask - 1, count++;
+  return count;
+  #endif
+}
+
+//returns the number of bytes that begin a character (every byte but 0b10xxxxxx)
+//for valid UTF-8, this is the number of characters
+inline auto count(const void* data, uint64_t size) -> uint64_t {
+  auto p = (const uint8_t*)data;
+  uint64_t characters = 0, n = 0;
+  #if defined(__SSE2__)
+  //as signed bytes, 0x80-0xbf are -128 to -65: every other byte compares greater than -65
+  auto continuation = _mm_set1_epi8(-65);
+  for(; n + 16 <= size; n += 16) {
+    auto x = _mm_loadu_si128((const __m128i*)(p + n));
+    characters += _count(_mm_movemask_epi8(_mm_cmpgt_epi8(x, continuation)));
+  }
+  #endif
+  for(; n < size; n++) characters += (p[n] & 0xc0) != 0x80;
+  return characters;
+}
+
+//returns the offset of the first byte that does not belong to a well-formed sequence (RFC 3629),
+//rejecting overlong encodings, surrogates, code points beyond U+10FFFF, and sequences cut short by the end of data
+inline auto invalid(const void* data, uint64_t size) -> maybe<uint64_t> {
+  auto p = (const uint8_t*)data;
+  uint64_t n = 0;
+  while(n < size) {
+    if(p[n] < 0x80) {
+      #if defined(__SSE2__)
+      //text is mostly ASCII: skip 16 bytes at a time while no byte has its high bit set
+      while(n + 16 <= size && !_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(p + n)))) n += 16;
+      #endif
+      while(n < size && p[n] < 0x80) n++;
+      continue;
+    }
+    uint8_t byte = p[n], lower = 0x80, upper = 0xbf;  //range of the second byte
+    uint length = 0;  //continuation bytes
+    if(byte >= 0xc2 && byte <= 0xdf) length = 1;
+    else if(byte >= 0xe0 && byte <= 0xef) length = 2, lower = byte == 0xe0 ? 0xa0 : 0x80, upper = byte == 0xed ? 0x9f : 0xbf;
+    else if(byte >= 0xf0 && byte <= 0xf4) length = 3, lower = byte == 0xf0 ? 0x90 : 0x80, upper = byte == 0xf4 ? 0x8f : 0xbf;
+    else return n;
+    if(size - n <= length) return n;
+    if(p[n + 1] < lower || p[n + 1] > upper) return n;
+    for(uint k = 2; k <= length; k++) {
+      if((p[n + k] & 0xc0) != 0x80) return n;
+    }
+    n += 1 + length;
+  }
+  return nothing;
+}
+
+inline auto valid(const void* data, uint64_t size) -> bool {
+  return !invalid(data, size);
+}
+
+//converts between byte and character offsets within a buffer
+//the character count is kept for every Stride bytes, so that a conversion only counts from the nearest checkpoint
+//the buffer is referenced, not copied: it must outlive the table, and not change while it is used
+struct Offsets {
+  static constexpr uint Stride = 4096;
+
+  Offsets() = default;
+  Offsets(const void* data, uint64_t size) { reset(data, size); }
+
+  auto reset() -> void {
+    _data = nullptr;
+    _size = 0;
+    _checkpoints.reset();
+    _invalid = nothing;
+  }
+
+  auto reset(const void* data, uint64_t size) -> void {
+    _data = (const uint8_t*)data;
+    _size = size;
+    _checkpoints.reset();
+    _checkpoints.reserve(size / Stride + 1);
+    uint64_t characters = 0;
+    for(uint64_t offset = 0; offset < size; offset += Stride) {
+      _checkpoints.append(characters);
+      characters += count(_data + offset, min((uint64_t)Stride, size - offset));
+    }
+    _checkpoints.append(characters);
+    _invalid = UTF8::invalid(data, size);
+  }
+
+  auto size() const -> uint64_t { return _size; }
+  auto valid() const -> bool { return !_invalid; }
+  auto invalid() const -> maybe<uint64_t> { return _invalid; }
+  auto characters() const -> uint64_t { return _checkpoints ? _checkpoints.right() : 0; }
+
+  //returns the number of characters that begin before the byte offset
+  auto characters(uint64_t offset) const -> uint64_t {
+    if(offset >= _size) return characters();
+    uint64_t checkpoint = offset / Stride;
+    return _checkpoints[checkpoint] + count(_data + checkpoint * Stride, offset - checkpoint * Stride);
+  }
+
+  //returns the byte offset of the character, or size() if there are not that many
+  auto offset(uint64_t character) const -> uint64_t {
+    if(character >= characters()) return _size;
+    //the last checkpoint at or before the character
+    uint64_t lower = 0, upper = _checkpoints.size() - 1;
+    while(upper - lower > 1) {
+      uint64_t middle = (lower + upper) / 2;
+      if(_checkpoints[middle] <= character) lower = middle;
+      else upper = middle;
+    }
+    uint64_t remaining = character - _checkpoints[lower];
+    uint64_t n = lower * Stride;
+    #if defined(__SSE2__)
+    auto continuation = _mm_set1_epi8(-65);
+    for(; n + 16 <= _size; n += 16) {
+      auto x = _mm_loadu_si128((const __m128i*)(_data + n));
+      uint characters = _count(_mm_movemask_epi8(_mm_cmpgt_epi8(x, continuation)));
+      if(characters > remaining) break;
+      remaining -= characters;
+    }
+    #endif
+    for(; n < _size; n++) {
+      if((_data[n] & 0xc0) == 0x80) continue;
+      if(!remaining--) return n;
+    }
+    return _size;
+  }
+
+private:
+  const uint8_t* _data = nullptr;
+  uint64_t _size = 0;
+  vector<uint64_t> _checkpoints;  //characters before each multiple of Stride, then the total
+  maybe<uint64_t> _invalid;
+};
+
+}
+
 namespace nall {
 
-//note: this function assumes the string contains valid UTF-8 characters
-//invalid characters will result in an incorrect result from this function
-//invalid case 1: byte 1 == 0b'01xxxxxx
-//invalid case 2: bytes 2-4 != 0b'10xxxxxx
-//invalid case 3: end of string without bytes 2-4 present
+//counts the bytes that begin a character within the range: see UTF8::count()
+//use UTF8::invalid() to detect text that is not valid UTF-8, as any such text will be miscounted
 inline auto characters(string_view self, int offset, int length) -> uint {
   uint characters = 0;
   if(offset < 0) offset = self.size() - abs(offset);
   if(offset >= 0 && offset < self.size()) {
     if(length < 0) length = self.size() - offset;
     if(length >= 0) {
-      for(int index = offset; index < offset + length;) {
-        auto byte = self.data()[index++];
-        if((byte & 0b111'00000) == 0b110'00000) index += 1;
-        if((byte & 0b1111'0000) == 0b1110'0000) index += 2;
-        if((byte & 0b11111'000) == 0b11110'000) index += 3;
-        characters++;
-      }
+      characters = UTF8::count(self.data() + offset, min(length, (int)self.size() - offset));
     }
   }
   return characters;
@@ -35,8 +35,9 @@ inline auto vector<string>::ifind(string_view source) const -> maybe<uint> {
 
 inline auto vector<string>::match(string_view pattern) const -> vector<string> {
   vector<string> result;
+  glob compiled{pattern};
   for(uint n = 0; n < size(); n++) {
-    if(operator[](n).match(pattern)) result.append(operator[](n));
+    if(compiled.match(operator[](n))) result.append(operator[](n));
   }
   return result;
 }
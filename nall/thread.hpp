@@ -29,6 +29,7 @@ struct thread {
   static auto create(const function<void (uintptr)>& callback, uintptr parameter = 0, uint stacksize = 0) -> thread;
   static auto detach() -> void;
   static auto exit() -> void;
+  static auto concurrency() -> uint;
 
   struct context {
     function<auto (uintptr) -> void> callback;
@@ -73,6 +74,12 @@ inline auto thread::exit() -> void {
   pthread_exit(nullptr);
 }
 
+//number of threads that can run simultaneously
+inline auto thread::concurrency() -> uint {
+  auto count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? count : 1;
+}
+
 }
 
 #elif defined(API_WINDOWS)
@@ -86,6 +93,7 @@ struct thread {
   static auto create(const function<void (uintptr)>& callback, uintptr parameter = 0, uint stacksize = 0) -> thread;
   static auto detach() -> void;
   static auto exit() -> void;
+  static auto concurrency() -> uint;
 
   struct context {
     function<auto (uintptr) -> void> callback;
@@ -139,6 +147,13 @@ inline auto thread::exit() -> void {
   ExitThread(0);
 }
 
+//number of threads that can run simultaneously
+inline auto thread::concurrency() -> uint {
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors ? info.dwNumberOfProcessors : 1;
+}
+
 }
 
 #endif
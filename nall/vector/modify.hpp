@@ -66,13 +66,15 @@ template<typename T> auto vector<T>::append(vector<T>&& values) -> void {
 
 template<typename T> auto vector<T>::insert(uint64_t offset, const T& value) -> void {
   if(offset == 0) return prepend(value);
-  if(offset == size() - 1) return append(value);
+  if(offset >= size()) return append(value);
   reserveRight(size() + 1);
-  _size++;
-  for(int64_t n = size() - 1; n > offset; n--) {
+  new(_pool + _size) T(move(_pool[_size - 1]));
+  for(int64_t n = _size - 1; n > offset; n--) {
     _pool[n] = move(_pool[n - 1]);
   }
-  new(_pool + offset) T(value);
+  _pool[offset] = value;
+  _right--;
+  _size++;
 }
 
 //
@@ -89,7 +91,7 @@ template<typename T> auto vector<T>::removeRight(uint64_t length) -> void {
 
 template<typename T> auto vector<T>::remove(uint64_t offset, uint64_t length) -> void {
   if(offset == 0) return removeLeft(length);
-  if(offset == size() - 1) return removeRight(length);
+  if(offset + length >= size()) return removeRight(size() - offset);
 
   for(uint64_t n = offset; n < size(); n++) {
     if(n + length < size()) {
@@ -98,6 +100,7 @@ template<typename T> auto vector<T>::remove(uint64_t offset, uint64_t length) ->
       _pool[n].~T();
     }
   }
+  _right += length;
   _size -= length;
 }
 
@@ -0,0 +1,79 @@
+#pragma once
+
+//lets worker threads wake an event loop that waits on descriptor(), instead of the loop polling for their results
+//Linux uses an eventfd; other POSIX platforms use a pipe; Windows has no descriptor, and is polled through clear()
+
+#include <nall/thread.hpp>
+
+#if defined(PLATFORM_LINUX)
+  #include <sys/eventfd.h>
+  #include <unistd.h>
+#elif defined(API_POSIX)
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+namespace nall {
+
+struct wakeup {
+  wakeup(const wakeup&) = delete;
+  auto operator=(const wakeup&) = delete;
+
+  //the descriptor is created here rather than on first use, as signal() may be called from any thread
+  wakeup() {
+    #if defined(PLATFORM_LINUX)
+    _read = _write = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    #elif defined(API_POSIX)
+    int fds[2];
+    if(pipe(fds) == 0) {
+      for(int fd : fds) {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+      }
+      _read = fds[0];
+      _write = fds[1];
+    }
+    #endif
+  }
+
+  ~wakeup() {
+    #if defined(API_POSIX)
+    if(_write >= 0 && _write != _read) ::close(_write);
+    if(_read >= 0) ::close(_read);
+    #endif
+  }
+
+  //readable from the first signal() until the next clear(); -1 when unavailable
+  auto descriptor() const -> int {
+    return _read;
+  }
+
+  //may be called from any thread, after the work it announces has been posted
+  auto signal() -> void {
+    if(_signalled.exchange(true)) return;  //already pending: the next clear() will see the work
+    #if defined(PLATFORM_LINUX)
+    uint64_t one = 1;
+    if(write(_write, &one, sizeof(one)) < 0) {}
+    #elif defined(API_POSIX)
+    char one = 1;
+    if(write(_write, &one, sizeof(one)) < 0) {}
+    #endif
+  }
+
+  //returns whether signal() was called since the last clear(): call it before handling the posted work
+  auto clear() -> bool {
+    #if defined(API_POSIX)
+    //drained before the flag is lowered, so that a signal() racing with clear() is never lost
+    char buffer[64];
+    while(_read >= 0 && read(_read, buffer, sizeof(buffer)) > 0);
+    #endif
+    return _signalled.exchange(false);
+  }
+
+private:
+  int _read = -1;
+  int _write = -1;
+  atomic<bool> _signalled = false;
+};
+
+}
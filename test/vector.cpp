@@ -0,0 +1,99 @@
+//checks nall::vector insert, remove and assignment against the element order and capacity they must leave behind
+//prints each failed check, and exits with a failure status if there was any
+
+#include <nall/nall.hpp>
+#include <nall/main.hpp>
+using namespace nall;
+
+namespace Test {
+
+uint failures = 0;
+
+auto check(bool condition, const char* name) -> void {
+  if(condition) return;
+  print("error: ", name, "\n");
+  failures++;
+}
+
+auto values(const vector<int>& v) -> string {
+  string text;
+  for(auto& value : v) text.append(value, " ");
+  return text.trimRight(" ", 1L);
+}
+
+//counts live instances, so that elements which are never destroyed can be noticed
+struct Tracked {
+  static inline int live = 0;
+  Tracked(int value = 0) : value(value) { live++; }
+  Tracked(const Tracked& source) : value(source.value) { live++; }
+  Tracked(Tracked&& source) : value(source.value) { live++; }
+  ~Tracked() { live--; }
+  auto operator=(const Tracked&) -> Tracked& = default;
+  auto operator=(Tracked&&) -> Tracked& = default;
+  int value;
+};
+
+auto insert() -> void {
+  vector<int> v;
+  v.reserve(16);
+  for(int n : range(8)) v.append(n);
+  v.insert(3, 30);
+  check(values(v) == "0 1 2 30 3 4 5 6 7", "insert() in the middle");
+  v.insert(v.size() - 1, 70);
+  check(values(v) == "0 1 2 30 3 4 5 6 70 7", "insert() before the last element");
+  v.insert(v.size(), 80);
+  check(values(v) == "0 1 2 30 3 4 5 6 70 7 80", "insert() at the end");
+  //an insert within the reserved space must not claim more of it than it uses
+  check(v.capacity() == 16, "insert() capacity");
+  while(v.size() < 16) v.append(0);
+  check(v.capacity() == 16, "append() after insert() capacity");
+
+  //elements that own memory are moved as they make room, and must end up in the same order
+  vector<string> s;
+  vector<int> w;
+  for(int n : range(64)) s.insert(s.size() / 2, string{n}), w.insert(w.size() / 2, n);
+  bool same = s.size() == w.size();
+  for(uint n : range(min(s.size(), w.size()))) same &= s[n] == string{w[n]};
+  check(same, "insert() of strings");
+}
+
+auto remove() -> void {
+  vector<int> v;
+  v.reserve(16);
+  for(int n : range(10)) v.append(n);
+  v.remove(2, 3);
+  check(values(v) == "0 1 5 6 7 8 9", "remove() in the middle");
+  v.remove(v.size() - 2, 2);
+  check(values(v) == "0 1 5 6 7", "remove() of the last elements");
+  v.remove(3, 10);
+  check(values(v) == "0 1 5", "remove() past the end");
+  //removed elements return their space to the right
+  check(v.capacity() == 16, "remove() capacity");
+  for(int n : range(13)) v.append(n);
+  check(v.capacity() == 16, "append() after remove() capacity");
+}
+
+auto assign() -> void {
+  {
+    vector<Tracked> x, y;
+    x.reserve(4), y.reserve(4);
+    for(int n : range(3)) x.append(n);
+    for(int n : range(2)) y.append(n);
+    x = y;
+    check(Tracked::live == 4, "copy assignment destroys the previous elements");
+    x = move(y);
+    check(Tracked::live == 2, "move assignment destroys the previous elements");
+    check(x.size() == 2 && x[1].value == 1 && !y, "move assignment contents");
+  }
+  check(Tracked::live == 0, "vector destroys its elements");
+}
+
+}
+
+auto nall::main(Arguments arguments) -> void {
+  Test::insert();
+  Test::remove();
+  Test::assign();
+  if(Test::failures) exit(EXIT_FAILURE);
+  print("vector: ok\n");
+}